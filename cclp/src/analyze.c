@@ -0,0 +1,251 @@
+/**
+ * CCLP - ChronoCode Language Packer: overdraw analyzer
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "analyze.h"
+#include "cclp.h"
+#include "packs.h"
+
+#define MAX_SCREEN 260 /**< Largest screen dimension */
+#define BLOCK_W 3      /**< Pixels per character of the ASCII heat map */
+#define BLOCK_H 6
+
+static const platform_t platforms[] = {
+  { "aplite",  144, 168, 20, 12, 18,  0,  0 },
+  { "basalt",  144, 168, 20, 12, 18,  0,  0 },
+  { "diorite", 144, 168, 20, 12, 18,  0,  0 },
+  { "flint",   144, 168, 20, 12, 18,  0,  0 },
+  { "chalk",   180, 180, 17, 10, 14, 30, 27 },
+  { "emery",   200, 228, 27, 16, 24,  4,  6 },
+  { "gabbro",  260, 260, 24, 14, 21, 46, 35 },
+};
+
+/**
+ * A word of the pack and its frame, clipped to the screen.
+ */
+typedef struct {
+  uint8_t word;       /**< Word number */
+  uint8_t row;
+  uint8_t col;
+  uint8_t width;
+  char text[MAX_TEXT + 1];
+  int x, y, w, h;     /**< Frame, as prv_word_frame() computes it */
+  int x0, y0, x1, y1; /**< Frame clipped to the screen, exclusive of x1 and y1 */
+} frame_t;
+
+const platform_t *find_platform(const char *name) {
+  size_t i;
+  for (i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++) {
+    if (strcmp(platforms[i].name, name) == 0) return &platforms[i];
+  }
+  return NULL;
+}
+
+static int clamp(int v, int max) {
+  return v < 0 ? 0 : v > max ? max : v;
+}
+
+/**
+ * Read the words of a language's pack, skipping those without text, which
+ * draw nothing.
+ *
+ * @param packs The packs file
+ * @param pack  The language's pack in it
+ * @return Number of frames
+ */
+static int read_frames(const uint8_t *packs, const uint8_t *pack, const platform_t *pf, frame_t *frames) {
+  const uint8_t *pool = &packs[get_u16(&packs[6])];
+  int i, n = 0;
+
+  for (i = 0; i < pack[0]; i++) {
+    const uint8_t *e = &pack[PACK_HEADER_SIZE + i * WORD_ENTRY_SIZE];
+    const int on_len = e[1] >> 4;
+    if (!on_len) continue;
+
+    frame_t *f = &frames[n++];
+    f->word = i + 1;
+    f->row = e[0] >> 4;
+    f->col = e[0] & 0x0F;
+    f->width = e[6];
+    memcpy(f->text, &pool[get_u16(&e[2])], on_len);
+    f->text[on_len] = '\0';
+
+    // As prv_word_frame() computes it
+    f->x = pf->grid_x + f->col * pf->font_w;
+    f->y = pf->grid_y + f->row * pf->font_h - pf->font_size / 10;
+    f->w = f->width * pf->font_w + 4;
+    f->h = pf->font_size * 13 / 10;
+    f->x0 = clamp(f->x, pf->screen_w);
+    f->y0 = clamp(f->y, pf->screen_h);
+    f->x1 = clamp(f->x + f->w, pf->screen_w);
+    f->y1 = clamp(f->y + f->h, pf->screen_h);
+  }
+  return n;
+}
+
+/**
+ * Print a word and its position in fixed-width columns.
+ */
+static void print_word(const frame_t *f) {
+  const int pad = 8 - utf8_length(f->text);
+  printf("%s%*s %2d,%-2d  ", f->text, pad > 0 ? pad : 0, "", f->row, f->col);
+}
+
+static void write_pgm(const char *path, int language, const platform_t *pf, const char *pgm_dir,
+                      uint8_t depth[MAX_SCREEN][MAX_SCREEN]) {
+  const char *base = strrchr(path, '/');
+  char *pgm_path = malloc(strlen(pgm_dir) + strlen(path) + strlen(pf->name) + 12);
+  FILE *fp;
+  int x, y;
+
+  base = base ? base + 1 : path;
+  const char *dot = strrchr(base, '.');
+  sprintf(pgm_path, "%s/%.*s.%d.%s.pgm", pgm_dir, (int)(dot ? dot - base : (long)strlen(base)), base, language, pf->name);
+  fp = fopen(pgm_path, "wb");
+  if (!fp) {
+    fprintf(stderr, "cclp: %s: cannot write\n", pgm_path);
+    free(pgm_path);
+    return;
+  }
+  // One grey level per frame covering the pixel
+  fprintf(fp, "P5\n%d %d\n255\n", pf->screen_w, pf->screen_h);
+  for (y = 0; y < pf->screen_h; y++) {
+    for (x = 0; x < pf->screen_w; x++) {
+      fputc(depth[y][x] > 4 ? 255 : depth[y][x] * 255 / 4, fp);
+    }
+  }
+  fclose(fp);
+  printf("Heat map written to %s\n", pgm_path);
+  free(pgm_path);
+}
+
+/**
+ * Print the frame of every word of a language's pack that has text, one per
+ * line: language, word number, x, y, width and height.
+ */
+static void print_frames(int language, const uint8_t *packs, const uint8_t *pack, const platform_t *pf) {
+  static frame_t frames[MAX_WORDS];
+  int i;
+
+  const int n = read_frames(packs, pack, pf, frames);
+  for (i = 0; i < n; i++) {
+    const frame_t *f = &frames[i];
+    printf("%d %d %d %d %d %d\n", language, f->word, f->x, f->y, f->w, f->h);
+  }
+}
+
+/**
+ * Analyze the pack of one language.
+ */
+static void analyze_pack(const char *path, int language, const uint8_t *packs, const uint8_t *pack,
+                         const platform_t *pf, const char *pgm_dir) {
+  static uint8_t depth[MAX_SCREEN][MAX_SCREEN];
+  static frame_t frames[MAX_WORDS];
+  uint8_t cells[16][16];
+  long area = 0, covered = 0, overdrawn = 0;
+  int max_depth = 0, pairs = 0, shared = 0;
+  int i, j, x, y;
+
+  const int n = read_frames(packs, pack, pf, frames);
+
+  memset(depth, 0, sizeof(depth));
+  memset(cells, 0, sizeof(cells));
+  for (i = 0; i < n; i++) {
+    const frame_t *f = &frames[i];
+    for (y = f->y0; y < f->y1; y++) {
+      for (x = f->x0; x < f->x1; x++) {
+        depth[y][x]++;
+      }
+    }
+    area += (long)(f->x1 - f->x0) * (f->y1 - f->y0);
+    for (x = f->col; x < f->col + f->width && x < 16; x++) {
+      cells[f->row][x]++;
+    }
+  }
+  for (y = 0; y < pf->screen_h; y++) {
+    for (x = 0; x < pf->screen_w; x++) {
+      if (depth[y][x] > 0) covered++;
+      if (depth[y][x] > 1) overdrawn++;
+      if (depth[y][x] > max_depth) max_depth = depth[y][x];
+    }
+  }
+
+  printf("%s, language %d on %s: %d layers\n", path, language, pf->name, n);
+  printf("  frame pixels %ld, screen pixels covered %ld, covered more than once %ld\n",
+    area, covered, overdrawn);
+  printf("  overdraw %ld pixels (%.0f%% of the covered pixels), at most %d frames deep\n",
+    area - covered, covered ? 100.0 * (area - covered) / covered : 0.0, max_depth);
+
+  // Overlapping pairs, and whether they only overlap by the frames' slack
+  // or share grid cells too
+  printf("  overlapping frames:\n");
+  for (i = 0; i < n; i++) {
+    const frame_t *a = &frames[i];
+    for (j = i + 1; j < n; j++) {
+      const frame_t *b = &frames[j];
+      const int w = (a->x1 < b->x1 ? a->x1 : b->x1) - (a->x0 > b->x0 ? a->x0 : b->x0);
+      const int h = (a->y1 < b->y1 ? a->y1 : b->y1) - (a->y0 > b->y0 ? a->y0 : b->y0);
+      if (w <= 0 || h <= 0) continue;
+      const int cells_shared = a->row == b->row &&
+        a->col < b->col + b->width && b->col < a->col + a->width;
+      printf("    ");
+      print_word(a);
+      print_word(b);
+      printf("%4d px%s\n", w * h, cells_shared ? "  shared cells" : "");
+      pairs++;
+    }
+  }
+  printf("  %d overlapping pairs\n", pairs);
+
+  printf("  grid cells covered by more than one layer:");
+  for (y = 0; y < 16; y++) {
+    for (x = 0; x < 16; x++) {
+      if (cells[y][x] > 1) {
+        printf(" %d,%d (%d)", y, x, cells[y][x]);
+        shared++;
+      }
+    }
+  }
+  printf(shared ? "\n" : " none\n");
+
+  // Heat map, each character showing the deepest pixel of its block
+  printf("  heat map (%dx%d pixels per character, frames per pixel):\n", BLOCK_W, BLOCK_H);
+  for (y = 0; y < pf->screen_h; y += BLOCK_H) {
+    printf("    ");
+    for (x = 0; x < pf->screen_w; x += BLOCK_W) {
+      int d = 0, bx, by;
+      for (by = y; by < y + BLOCK_H && by < pf->screen_h; by++) {
+        for (bx = x; bx < x + BLOCK_W && bx < pf->screen_w; bx++) {
+          if (depth[by][bx] > d) d = depth[by][bx];
+        }
+      }
+      putchar(d == 0 ? ' ' : d == 1 ? '.' : d > 9 ? '#' : '0' + d);
+    }
+    printf("\n");
+  }
+
+  if (pgm_dir) write_pgm(path, language, pf, pgm_dir, depth);
+}
+
+int analyze_packs(const char *path, const platform_t *pf, const char *pgm_dir, int frames) {
+  static uint8_t packs[1 << 20];
+  static uint8_t unpacked[UNPACKED_SIZE];
+  const size_t size = read_packs("cclp", path, packs, sizeof(packs));
+  const uint8_t *pack;
+  int i;
+
+  if (!size) return 1;
+  for (i = 0; i < packs[5]; i++) {
+    if (get_pack("cclp", path, packs, size, i, unpacked, &pack)) return 1;
+    if (!pack) continue;
+    if (frames) print_frames(i, packs, pack, pf);
+    else analyze_pack(path, i, packs, pack, pf, pgm_dir);
+  }
+  return 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * CCLP - ChronoCode Language Packer: overdraw analyzer
+ *
+ * Loads a packs file, reconstructs the frame of every text layer the watch
+ * creates for each of its languages (see prv_word_frame() in
+ * src/chronocode.c) and reports how much the frames overlap: the pixels
+ * covered by more than one frame, the pairs of overlapping frames and the
+ * grid cells shared by more than one word. Every pixel of a frame is
+ * rasterized when the layer is redrawn, so overlapping frames are wasted
+ * work.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#pragma once
+
+/**
+ * Screen and grid metrics of a platform, as in src/chronocode.h (make test
+ * in host/ checks the frames they give against the watch's).
+ */
+typedef struct {
+  const char *name;
+  int screen_w;
+  int screen_h;
+  int font_size;
+  int font_w;
+  int font_h;
+  int grid_x;
+  int grid_y;
+} platform_t;
+
+/**
+ * Find a platform by name.
+ *
+ * @return The platform, or NULL if there is no such platform
+ */
+const platform_t *find_platform(const char *name);
+
+/**
+ * Analyze the language packs of a packs file and print the report and an
+ * ASCII heat map of the overdraw for each language.
+ *
+ * @param pgm_dir Directory to write PGM heat maps to, or NULL
+ * @param frames  Print only the frame of every word instead, one per line:
+ *                language, word number, x, y, width and height (the host
+ *                test compares them with the watch's, see host/Makefile)
+ * @return 0 on success, or 1 if the file cannot be read
+ */
+int analyze_packs(const char *path, const platform_t *platform, const char *pgm_dir, int frames);
@@ -0,0 +1,253 @@
+/**
+ * CCGA - ChronoCode Glyph Atlas generator
+ *
+ * Rasterizes the glyphs used by the language packs into a glyph atlas
+ * resource, so that the watch can blit pre-rendered glyphs rather than
+ * rasterizing the fonts on every redraw.
+ *
+ * Each code point used by the packs is rendered into a fixed-size cell in
+ * the weights it is displayed with: text shown when a word is "on" can be
+ * drawn with either font (all caps mode shows it "off" too), while text
+ * shown when a word is "off" only ever uses the "off" font. If both fonts
+ * are the same file, as on color platforms, only one weight is stored.
+ *
+ * Atlas format (little-endian):
+ *
+ *   0  char[4] magic "CCGA"
+ *   4  uint8   format version (1)
+ *   5  uint8   bits per pixel (1 = black/white, 2 = four levels of coverage)
+ *   6  uint8   cell width in pixels
+ *   7  uint8   cell height in pixels
+ *   8  uint16  number of glyphs
+ *  10  uint16  bytes per cell
+ *  12  glyph index: per glyph uint16 code point, uint8 weight (0 = on, 1 = off), uint8 reserved
+ *  ..  cells: per glyph, rows top to bottom, first pixel in the most significant bits
+ *
+ * The index is sorted by code point, then weight.
+ *
+ * Atlases are only made for the 144x168 screens (aplite, basalt, diorite and
+ * flint), whose 20px fonts the cell size below matches; the watch draws the
+ * other screens with the fonts (see GLYPH_ATLAS_RENDERER in
+ * src/chronocode.h).
+ *
+ * Usage: ccga <bits per pixel> <output file> <"on" font> <"off" font> <packs.cclp>...
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "cclp.h"
+#include "packs.h"
+
+#define FONT_SIZE 20   /**< Pixel size of the 144x168 fonts, as in the font resource names */
+#define CELL_W 12      /**< Cell width, the same as FONT_W on the watch */
+#define CELL_H 26      /**< Cell height, the same as the word frame height (WORD_H = FONT_SIZE * 13 / 10) */
+#define MAX_GLYPHS 256
+
+typedef struct {
+  uint16_t codepoint;
+  uint8_t weight;
+} glyph_t;
+
+static glyph_t glyphs[MAX_GLYPHS];
+static int glyph_count;
+static int single_weight; /**< Both fonts are the same, so store every glyph as "on" only */
+
+/**
+ * Decode one UTF-8 sequence, returning the number of bytes consumed.
+ */
+static int utf8_decode(const char *s, uint32_t *cp) {
+  const uint8_t *u = (const uint8_t *)s;
+  if (u[0] < 0x80) { *cp = u[0]; return 1; }
+  if ((u[0] & 0xE0) == 0xC0) { *cp = ((u[0] & 0x1F) << 6) | (u[1] & 0x3F); return 2; }
+  if ((u[0] & 0xF0) == 0xE0) { *cp = ((u[0] & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F); return 3; }
+  *cp = '?';
+  return 1;
+}
+
+static void add_glyph(uint32_t cp, uint8_t weight) {
+  int i;
+  if (cp == ' ') return; // Nothing to draw
+  for (i = 0; i < glyph_count; i++) {
+    if (glyphs[i].codepoint == cp && glyphs[i].weight == weight) return;
+  }
+  if (glyph_count == MAX_GLYPHS) {
+    fprintf(stderr, "ccga: too many glyphs\n");
+    exit(1);
+  }
+  glyphs[glyph_count].codepoint = (uint16_t)cp;
+  glyphs[glyph_count].weight = weight;
+  glyph_count++;
+}
+
+static void add_text(const char *text, int len, int on_weights) {
+  int i = 0;
+  uint32_t cp;
+  while (i < len && text[i]) {
+    i += utf8_decode(&text[i], &cp);
+    if (single_weight) {
+      add_glyph(cp, 0);
+      continue;
+    }
+    add_glyph(cp, 1);
+    if (on_weights) add_glyph(cp, 0);
+  }
+}
+
+/**
+ * Collect the glyphs used by the words of all the language packs of a packs
+ * file (see packs.h).
+ */
+static void scan_packs(const char *path) {
+  static uint8_t data[1 << 20];
+  static uint8_t unpacked[UNPACKED_SIZE];
+  const size_t size = read_packs("ccga", path, data, sizeof(data));
+  const uint8_t *pack;
+  int i, j, l;
+
+  if (!size) exit(1);
+  const uint8_t *pool = &data[get_u16(&data[6])];
+  for (l = 0; l < data[5]; l++) {
+    if (get_pack("ccga", path, data, size, l, unpacked, &pack)) exit(1);
+    if (!pack) continue;
+    for (i = 0; i < pack[0]; i++) {
+      const uint8_t *e = &pack[PACK_HEADER_SIZE + i * WORD_ENTRY_SIZE];
+      const int on_len = e[1] >> 4;
+      const uint16_t on = get_u16(&e[2]);
+      const uint16_t off = get_u16(&e[4]);
+      char text[MAX_TEXT + 1];
+      add_text((const char *)&pool[on], on_len, 1);
+      if (off == TEXT_DERIVED) {
+        // Lowercased "on" text
+        for (j = 0; j < on_len; j++) {
+          const char c = pool[on + j];
+          text[j] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+        }
+        add_text(text, on_len, 0);
+      } else {
+        add_text((const char *)&pool[off], e[1] & 0x0F, 0);
+      }
+    }
+  }
+}
+
+static int glyph_cmp(const void *a, const void *b) {
+  const glyph_t *ga = a, *gb = b;
+  if (ga->codepoint != gb->codepoint) return ga->codepoint - gb->codepoint;
+  return ga->weight - gb->weight;
+}
+
+/**
+ * Render one glyph into a cell, quantizing coverage to the atlas bit depth.
+ */
+static void render_glyph(FT_Face face, const glyph_t *g, int bpp, uint8_t *cell, int stride) {
+  int baseline = (int)(face->size->metrics.ascender >> 6);
+  int x, y;
+
+  if (FT_Load_Char(face, g->codepoint, FT_LOAD_RENDER | (bpp == 1 ? FT_LOAD_TARGET_MONO : 0))) {
+    fprintf(stderr, "ccga: cannot render U+%04X\n", g->codepoint);
+    exit(1);
+  }
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Bitmap *bm = &slot->bitmap;
+  if (FT_Get_Char_Index(face, g->codepoint) == 0) {
+    fprintf(stderr, "ccga: warning: font has no glyph for U+%04X\n", g->codepoint);
+  }
+
+  for (y = 0; y < (int)bm->rows; y++) {
+    const int cy = baseline - slot->bitmap_top + y;
+    if (cy < 0 || cy >= CELL_H) continue;
+    for (x = 0; x < (int)bm->width; x++) {
+      const int cx = slot->bitmap_left + x;
+      int level;
+      if (cx < 0 || cx >= CELL_W) continue;
+      if (bm->pixel_mode == FT_PIXEL_MODE_MONO) {
+        level = (bm->buffer[y * bm->pitch + (x >> 3)] >> (7 - (x & 7))) & 1 ? 3 : 0;
+      } else {
+        level = (bm->buffer[y * bm->pitch + x] * 3 + 127) / 255;
+      }
+      if (bpp == 1) {
+        if (level >= 2) cell[cy * stride + (cx >> 3)] |= 0x80 >> (cx & 7);
+      } else {
+        cell[cy * stride + (cx >> 2)] |= level << (6 - 2 * (cx & 3));
+      }
+    }
+  }
+}
+
+static void write_u16(FILE *fp, uint16_t v) {
+  fputc(v & 0xFF, fp);
+  fputc(v >> 8, fp);
+}
+
+int main(int argc, char **argv) {
+  FT_Library library;
+  FT_Face faces[2];
+  int bpp, i;
+
+  if (argc < 6) {
+    fprintf(stderr, "usage: %s <bits per pixel> <output file> <on font> <off font> <packs.cclp>...\n", argv[0]);
+    return 2;
+  }
+  bpp = atoi(argv[1]);
+  if (bpp != 1 && bpp != 2) {
+    fprintf(stderr, "ccga: bits per pixel must be 1 or 2\n");
+    return 2;
+  }
+  single_weight = strcmp(argv[3], argv[4]) == 0;
+
+  for (i = 5; i < argc; i++) {
+    scan_packs(argv[i]);
+  }
+  qsort(glyphs, glyph_count, sizeof(glyph_t), glyph_cmp);
+
+  if (FT_Init_FreeType(&library)) {
+    fprintf(stderr, "ccga: cannot initialize FreeType\n");
+    return 1;
+  }
+  for (i = 0; i < 2; i++) {
+    if (FT_New_Face(library, argv[3 + i], 0, &faces[i]) || FT_Set_Pixel_Sizes(faces[i], 0, FONT_SIZE)) {
+      fprintf(stderr, "ccga: cannot load font %s\n", argv[3 + i]);
+      return 1;
+    }
+  }
+
+  const int stride = (CELL_W * bpp + 7) / 8;
+  const int cell_size = stride * CELL_H;
+  FILE *fp = fopen(argv[2], "wb");
+  if (!fp) {
+    perror(argv[2]);
+    return 1;
+  }
+  fwrite("CCGA", 1, 4, fp);
+  fputc(1, fp);
+  fputc(bpp, fp);
+  fputc(CELL_W, fp);
+  fputc(CELL_H, fp);
+  write_u16(fp, glyph_count);
+  write_u16(fp, cell_size);
+  for (i = 0; i < glyph_count; i++) {
+    write_u16(fp, glyphs[i].codepoint);
+    fputc(glyphs[i].weight, fp);
+    fputc(0, fp);
+  }
+  for (i = 0; i < glyph_count; i++) {
+    uint8_t cell[CELL_H * 3];
+    memset(cell, 0, sizeof(cell));
+    render_glyph(faces[glyphs[i].weight], &glyphs[i], bpp, cell, stride);
+    fwrite(cell, 1, cell_size, fp);
+  }
+  fclose(fp);
+
+  printf("%s: %d glyphs, %d bytes\n", argv[2], glyph_count, 12 + glyph_count * (4 + cell_size));
+  FT_Done_Face(faces[0]);
+  FT_Done_Face(faces[1]);
+  FT_Done_FreeType(library);
+  return 0;
+}
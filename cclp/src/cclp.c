@@ -1,59 +1,691 @@
 /**
  * CCLP - ChronoCode Language Packer
  *
- * Parses language pack files (currently written as C files), and writes them
- * out to binary files ready to be read as a raw Pebble resource file.
+ * Parses language pack sources (cclp/chronocode.xx_XX.json), and writes them
+ * out to a single binary file ready to be read as a raw Pebble resource file:
  *
- * Very rough and bare bones at the moment, but it gets the job done.
+ *   cclp [-r] <output.cclp> <source.json>...
+ *
+ * writes the packs of all the sources to <output.cclp>, compressing the word
+ * entries of those that gain enough from it unless -r is given (see
+ * choose_encoding()), and
+ *
+ *   cclp -a [-f] [-p <platform>] [-m <directory>] <packs.cclp>...
+ *
+ * analyzes the overdraw of the packs' layers on a platform (default: aplite)
+ * instead (see analyze.h), optionally writing PGM heat maps to a directory,
+ * or with -f only prints the frames of the layers.
+ *
+ * Besides the words themselves, the packer evaluates the phrase for every
+ * hour and five-minute interval and writes the resulting set of lit words as
+ * a table, so the watch does not need any language-specific logic.
+ *
+ * Packs file format, version 6 (little-endian):
+ *
+ *   0  char[4] magic "CCLP"
+ *   4  uint8   format version (6)
+ *   5  uint8   number of index entries, n (languages 0 to n-1)
+ *   6  uint16  offset of the string pool
+ *   8  uint16  size of the string pool in bytes
+ *  10  uint32  CRC-32 of the string pool
+ *  14  uint32  size of the file in bytes
+ *  18  index, 6 bytes per language ID:
+ *        uint32 offset of the language's pack
+ *        uint16 size of the language's pack, or 0 if there is none
+ *   ..  string pool: the texts of all the languages, without terminators; a
+ *       text may overlap another text that it is a part of, or that it
+ *       starts or ends with
+ *   ..  the language packs
+ *
+ * Language pack:
+ *
+ *   0  uint8   number of words, n (word 0 is never stored; entries are words 1-n,
+ *              where n is the last word used by the language)
+ *   1  uint8   grid columns
+ *   2  uint8   grid rows
+ *   3  uint8   encoding of the word entries: 0 = raw, 1 = compressed (see
+ *              lz.h); the lit-word table is always raw, so that any of its
+ *              entries can be read directly
+ *   4  uint32  CRC-32 of the rest of the pack (bytes 8 to the end), with the
+ *              word entries decoded
+ *   8  word entries, 7 bytes each:
+ *        uint8  (row << 4) | col
+ *        uint8  (length of text_on << 4) | length of text_off, in bytes
+ *        uint16 offset of text_on in the string pool
+ *        uint16 offset of text_off in the string pool, or 0xFFFF if text_off
+ *               is text_on with ASCII letters lowercased (its length is then
+ *               the length of text_on)
+ *        uint8  width of the word in characters (grid cells), the longer of
+ *               text_on and text_off
+ *   ..  lit-word table, the last LIT_TABLE_SIZE bytes of the pack: 2 (rounded)
+ *       x 12 (hours) x 12 (intervals) 64-bit bitmaps of the words to be lit
+ *       (bit N is word N)
+ *
+ * Source format (JSON):
+ *
+ *   "comment"   Ignored; a string or an array of strings (e.g. the grid)
+ *   "language"  Language ID, as in the settings (LANG_* in src/chronocode.h)
+ *   "solve"     Optional {"rows", "cols"}: lay the words out in a grid of this
+ *               size with the layout solver (see solve.h) instead of placing
+ *               them where the words say; the words are then in reading
+ *               order and need no "row" or "col" (if they have them, as when
+ *               a source is switched to the solver, words lit together must
+ *               be listed in the order they are read in that grid)
+ *   "words"     Array of words, each an object with:
+ *                 "index"   Word number, 1-63 (default: the previous word's
+ *                           number + 1, or 1 for the first word); words 1-12
+ *                           are the hours
+ *                 "name"    Optional name, for referring to the word
+ *                 "row", "col", "on", "off"
+ *                           Position in the grid and text when lit/unlit
+ *                 "comment" Ignored
+ *   "alwaysOn"  Array of words lit at all times
+ *   "intervals" Array of the 12 five-minute intervals of the hour, each an
+ *               object with:
+ *                 "words"    Array of words lit during the interval
+ *                 "nextHour" true if the phrase refers to the next hour
+ *   "rules"     Optional array of rules for what the intervals cannot express
+ *               (e.g. a different article for one o'clock), applied in order
+ *               after the hour word is lit. Each is an object with:
+ *                 "hours"   Array of the hours (1-12, after "nextHour") the
+ *                           rule applies to (default: all)
+ *                 "minutes" [first, last] minute the rule applies to
+ *                           (default: [0, 59])
+ *                 "on"      Array of words to light
+ *                 "off"     Array of words to turn off
+ *                 "comment" Ignored
+ *
+ * Words are referred to by number or by name.
  *
- * @todo Use JSON files to define language packs?
  * @license New BSD License (please see LICENSE file)
  * @repo https://github.com/rexmac/pebble-chronocode
  * @author Rex McConnell <rex@rexmac.com>
  */
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "analyze.h"
+#include "cclp.h"
+#include "lz.h"
+#include "solve.h"
+
+void die(const lang_t *lang, const json_t *value, const char *format, ...) {
+  va_list args;
+  fprintf(stderr, "cclp: %s", lang->path);
+  if (value) fprintf(stderr, ":%d", value->line);
+  fprintf(stderr, ": ");
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+  fprintf(stderr, "\n");
+  exit(1);
+}
+
+/**
+ * Get a member of an object, checking its type.
+ *
+ * @param required Exit with an error if the member is missing
+ */
+static json_t *get(const lang_t *lang, const json_t *object, const char *key, json_type_t type, int required) {
+  json_t *value = json_get(object, key);
+  if (!value) {
+    if (required) die(lang, object, "missing \"%s\"", key);
+    return NULL;
+  }
+  if (value->type != type) die(lang, value, "wrong type for \"%s\"", key);
+  return value;
+}
 
-typedef struct {
-  uint8_t x;
-  uint8_t y;
-  char text_on[16];
-  char text_off[16];
-} word_t;
-
-//#include "chronocode.da_DK.c"
-//#include "chronocode.de_DE.c"
-//#include "chronocode.en_US.c"
-//#include "chronocode.es_ES.c"
-//#include "chronocode.fr_FR.c"
-//#include "chronocode.it_IT.c"
-//#include "chronocode.nl_BE.c"
-//#include "chronocode.nl_NL.c"
-#include "chronocode.pt_PT.c"
-//#include "chronocode.sv_SE.c"
-
-int main() {
+/**
+ * Get an integer member of an object, checking its range.
+ */
+static int get_int(const lang_t *lang, const json_t *object, const char *key, int min, int max) {
+  const json_t *value = get(lang, object, key, JSON_NUMBER, 1);
+  if (value->number != (int)value->number || value->number < min || value->number > max) {
+    die(lang, value, "\"%s\" must be an integer from %d to %d", key, min, max);
+  }
+  return (int)value->number;
+}
+
+static void get_text(const lang_t *lang, const json_t *object, const char *key, char *text) {
+  const json_t *value = get(lang, object, key, JSON_STRING, 1);
+  if (strlen(value->string) > MAX_TEXT) {
+    die(lang, value, "\"%s\" is longer than %d bytes", value->string, MAX_TEXT);
+  }
+  strcpy(text, value->string);
+}
+
+/**
+ * Resolve a reference to a word, by number or by name.
+ */
+static int word_ref(const lang_t *lang, const json_t *ref) {
+  int i;
+  if (ref->type == JSON_NUMBER) {
+    i = (int)ref->number;
+    if (ref->number != i || i < 1 || i >= MAX_WORDS) die(lang, ref, "invalid word number");
+    return i;
+  }
+  if (ref->type == JSON_STRING) {
+    for (i = 1; i < MAX_WORDS; i++) {
+      if (lang->words[i].name && strcmp(lang->words[i].name, ref->string) == 0) return i;
+    }
+    die(lang, ref, "unknown word \"%s\"", ref->string);
+  }
+  die(lang, ref, "a word must be a number or a name");
+  return 0;
+}
+
+/**
+ * Get an array of word references as a bitmap.
+ */
+static uint64_t get_words(const lang_t *lang, const json_t *object, const char *key, int required) {
+  const json_t *array = get(lang, object, key, JSON_ARRAY, required);
+  const json_t *ref;
+  uint64_t words = 0;
+  for (ref = array ? array->child : NULL; ref; ref = ref->next) {
+    words |= (uint64_t)1 << word_ref(lang, ref);
+  }
+  return words;
+}
+
+static void parse_words(lang_t *lang, const json_t *root) {
+  const json_t *array = get(lang, root, "words", JSON_ARRAY, 1);
+  const json_t *item;
+  int index = 0;
+  for (item = array->child; item; item = item->next) {
+    if (item->type != JSON_OBJECT) die(lang, item, "a word must be an object");
+    index = json_get(item, "index") ? get_int(lang, item, "index", 1, MAX_WORDS - 1) : index + 1;
+    if (index >= MAX_WORDS) die(lang, item, "too many words");
+    if ((lang->defined >> index) & 1) die(lang, item, "word %d is defined twice", index);
+    lang->defined |= (uint64_t)1 << index;
+    lang->order[lang->order_count++] = index;
+
+    word_t *w = &lang->words[index];
+    const json_t *name = get(lang, item, "name", JSON_STRING, 0);
+    if (name) {
+      int i;
+      for (i = 1; i < MAX_WORDS; i++) {
+        if (lang->words[i].name && strcmp(lang->words[i].name, name->string) == 0) {
+          die(lang, name, "word name \"%s\" is used twice", name->string);
+        }
+      }
+      w->name = name->string;
+    }
+    // The layout solver places the words itself, but a position given
+    // anyway shows the reading order the source is meant to follow
+    if (!lang->solve_rows || json_get(item, "row") || json_get(item, "col")) {
+      w->row = get_int(lang, item, "row", 0, 15);
+      w->col = get_int(lang, item, "col", 0, 15);
+      if (lang->solve_rows) lang->placed |= (uint64_t)1 << index;
+    }
+    get_text(lang, item, "on", w->text_on);
+    get_text(lang, item, "off", w->text_off);
+  }
+}
+
+static void parse_intervals(lang_t *lang, const json_t *root) {
+  const json_t *array = get(lang, root, "intervals", JSON_ARRAY, 1);
+  const json_t *item;
+  int interval = 0;
+  for (item = array->child; item; item = item->next) {
+    if (item->type != JSON_OBJECT) die(lang, item, "an interval must be an object");
+    if (++interval > 12) die(lang, item, "more than 12 intervals");
+    lang->intervals[interval] = get_words(lang, item, "words", 1);
+    const json_t *next_hour = get(lang, item, "nextHour", JSON_BOOL, 0);
+    if (next_hour && next_hour->number) lang->next_hour |= 1 << interval;
+  }
+  if (interval != 12) die(lang, array, "expected 12 intervals");
+}
+
+static void parse_rules(lang_t *lang, const json_t *root) {
+  const json_t *array = get(lang, root, "rules", JSON_ARRAY, 0);
+  const json_t *item, *hour;
+  for (item = array ? array->child : NULL; item; item = item->next) {
+    if (item->type != JSON_OBJECT) die(lang, item, "a rule must be an object");
+    if (lang->rule_count == MAX_RULES) die(lang, item, "more than %d rules", MAX_RULES);
+    rule_t *rule = &lang->rules[lang->rule_count++];
+
+    const json_t *hours = get(lang, item, "hours", JSON_ARRAY, 0);
+    rule->hours = hours ? 0 : 0x1FFE;
+    for (hour = hours ? hours->child : NULL; hour; hour = hour->next) {
+      if (hour->type != JSON_NUMBER || hour->number != (int)hour->number ||
+          hour->number < 1 || hour->number > 12) {
+        die(lang, hour, "an hour must be an integer from 1 to 12");
+      }
+      rule->hours |= 1 << (int)hour->number;
+    }
+
+    const json_t *minutes = get(lang, item, "minutes", JSON_ARRAY, 0);
+    rule->min_first = 0;
+    rule->min_last = 59;
+    if (minutes) {
+      const json_t *first = minutes->child;
+      const json_t *last = first ? first->next : NULL;
+      if (!last || last->next || first->type != JSON_NUMBER || last->type != JSON_NUMBER ||
+          first->number < 0 || first->number > last->number || last->number > 59) {
+        die(lang, minutes, "\"minutes\" must be [first, last], from 0 to 59");
+      }
+      rule->min_first = (int)first->number;
+      rule->min_last = (int)last->number;
+    }
+
+    rule->on = get_words(lang, item, "on", 0);
+    rule->off = get_words(lang, item, "off", 0);
+  }
+}
+
+/**
+ * Check that the words of a "solve" source that also give their positions
+ * are listed in reading order: of two words lit together, the one listed
+ * first must come first in the grid.
+ */
+static void check_reading_order(const lang_t *lang) {
+  uint64_t table[LIT_SLOTS];
+  uint64_t together[MAX_WORDS] = { 0 }; /**< Words lit together with each word */
+  int i, j;
+
+  lit_table(lang, table);
+  for (i = 0; i < LIT_SLOTS; i++) {
+    for (uint64_t bits = table[i] & lang->placed; bits; bits &= bits - 1) {
+      together[__builtin_ctzll(bits)] |= table[i];
+    }
+  }
+  for (i = 0; i < lang->order_count; i++) {
+    const word_t *a = &lang->words[lang->order[i]];
+    for (j = i + 1; j < lang->order_count; j++) {
+      const int b_index = lang->order[j];
+      const word_t *b = &lang->words[b_index];
+      if (!((together[lang->order[i]] & lang->placed) >> b_index & 1)) continue;
+      if (b->row < a->row || (b->row == a->row && b->col < a->col)) {
+        die(lang, NULL, "\"%s\" is lit with \"%s\" and comes before it in the grid, but is listed after it; "
+            "the words of a \"solve\" source must be in reading order", b->text_on, a->text_on);
+      }
+    }
+  }
+}
+
+/**
+ * Read and parse a language pack source.
+ *
+ * @return The JSON document, which owns the word names of the language
+ */
+static json_t *load_lang(lang_t *lang, const char *path) {
   FILE *fp;
-  fp = fopen("packed", "wb");
+  long size;
+  char *text;
+  char error[128];
+  json_t *root;
+
+  memset(lang, 0, sizeof(*lang));
+  lang->path = path;
+  fp = fopen(path, "rb");
+  if (!fp) die(lang, NULL, "cannot open file");
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  text = malloc(size + 1);
+  if (!text || fread(text, 1, size, fp) != (size_t)size) die(lang, NULL, "cannot read file");
+  text[size] = '\0';
+  fclose(fp);
+
+  root = json_parse(text, error, sizeof(error));
+  free(text);
+  if (!root) die(lang, NULL, "%s", error);
+  if (root->type != JSON_OBJECT) die(lang, root, "expected an object");
+
+  lang->language = get_int(lang, root, "language", 0, MAX_LANGUAGES - 1);
+  const json_t *solve = get(lang, root, "solve", JSON_OBJECT, 0);
+  if (solve) {
+    lang->solve_rows = get_int(lang, solve, "rows", 1, 16);
+    lang->solve_cols = get_int(lang, solve, "cols", 1, 16);
+  }
+  parse_words(lang, root);
+  lang->always_on = get_words(lang, root, "alwaysOn", 0);
+  parse_intervals(lang, root);
+  parse_rules(lang, root);
+  if (lang->placed) check_reading_order(lang);
+  return root;
+}
+
+/**
+ * Compute the lit words for one slot of the lit-word table.
+ *
+ * @param hour     Hour (1-12) of the time being displayed
+ * @param interval Five-minute interval (1-12)
+ * @param rounded  True if the time was rounded up to this interval by the
+ *                 "two-minute dots" setting, i.e. it is one or two minutes
+ *                 before the interval rather than zero to two minutes after
+ */
+static uint64_t lit_words(const lang_t *lang, int hour, int interval, int rounded) {
+  // A representative minute for the slot, for rules that look at the minute
+  int min = (interval - 1) * 5 - rounded;
+  if (min < 0) min += 60;
+  int i;
+
+  // Permanent and interval words
+  uint64_t lit = lang->always_on | lang->intervals[interval];
+
+  // Refer to current hour or next hour?
+  if ((lang->next_hour >> interval) & 1) {
+    if (++hour > 12) hour = 1;
+  }
+  lit &= ~(uint64_t)0x1FFE;
+  lit |= (uint64_t)1 << hour;
+
+  for (i = 0; i < lang->rule_count; i++) {
+    const rule_t *rule = &lang->rules[i];
+    if (((rule->hours >> hour) & 1) && min >= rule->min_first && min <= rule->min_last) {
+      lit = (lit & ~rule->off) | rule->on;
+    }
+  }
+
+  return lit;
+}
+
+void lit_table(const lang_t *lang, uint64_t *table) {
+  int rounded, hour, interval;
+  for (rounded = 0; rounded < 2; rounded++) {
+    for (hour = 1; hour <= 12; hour++) {
+      for (interval = 1; interval <= 12; interval++) {
+        *table++ = lit_words(lang, hour, interval, rounded);
+      }
+    }
+  }
+}
+
+static uint8_t pool[MAX_LANGUAGES * MAX_WORDS * 2 * MAX_TEXT];
+static uint16_t pool_size;
+
+/**
+ * Add a text to the string pool, reusing any existing copy of it, or
+ * overlapping the end of the pool with its start.
+ *
+ * @return Offset of the text in the pool
+ */
+static uint16_t pool_add(const char *text) {
+  const int len = strlen(text);
+  int i;
+  for (i = 0; i + len <= pool_size; i++) {
+    if (memcmp(&pool[i], text, len) == 0) return i;
+  }
+  for (i = len - 1; i > 0; i--) {
+    if (i <= pool_size && memcmp(&pool[pool_size - i], text, i) == 0) break;
+  }
+  memcpy(&pool[pool_size], text + i, len - i);
+  pool_size += len - i;
+  return pool_size - len;
+}
+
+/**
+ * Check whether text_off can be derived from text_on by lowercasing ASCII letters.
+ */
+static int is_derived(const word_t *w) {
+  int i;
+  for (i = 0; w->text_on[i]; i++) {
+    const char c = w->text_on[i];
+    if (w->text_off[i] != ((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c)) return 0;
+  }
+  return w->text_off[i] == '\0';
+}
+
+int utf8_length(const char *text) {
+  int n = 0;
+  for (; *text; text++) {
+    if ((*text & 0xC0) != 0x80) n++;
+  }
+  return n;
+}
+
+/**
+ * CRC-32 (IEEE 802.3), as computed by the watch when loading a pack.
+ */
+static uint32_t crc32(const uint8_t *data, size_t size) {
+  uint32_t crc = 0xFFFFFFFF;
+  size_t i;
+  int b;
+  for (i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (b = 0; b < 8; b++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+static void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+  put_u16(p, v & 0xFFFF);
+  put_u16(p + 2, v >> 16);
+}
+
+void build_pool(const lang_t *langs, int count) {
+  int len, l, i;
+  pool_size = 0;
+  for (len = MAX_TEXT; len > 0; len--) {
+    for (l = 0; l < count; l++) {
+      for (i = 1; i < MAX_WORDS; i++) {
+        const word_t *w = &langs[l].words[i];
+        if ((int)strlen(w->text_on) == len) pool_add(w->text_on);
+        if (!is_derived(w) && (int)strlen(w->text_off) == len) pool_add(w->text_off);
+      }
+    }
+  }
+}
+
+uint16_t build_pack(const lang_t *lang, const uint64_t *table, uint8_t *pack) {
   uint8_t i;
-  uint8_t n;
   const word_t *w;
-  for(i = 1; i < 54; i++) {
-    w = &words[i];
-    n = (w->x << 4) | w->y;
-    fwrite(&n, sizeof(n), 1, fp);
-    fwrite(w->text_on, sizeof(w->text_on[0]), sizeof(w->text_on)/sizeof(w->text_on[0]), fp);
-    fwrite(w->text_off, sizeof(w->text_off[0]), sizeof(w->text_off)/sizeof(w->text_off[0]), fp);
-  }
-  // Begin writing interval logic - we're now at byte 1431 (0x597)
-  for(i = 0; i < 13; i++) {
-    fwrite(&intervals[i][0], 1, 1, fp);
-    fwrite(&intervals[i][1], 1, 1, fp);
-    fwrite(&intervals[i][2], 1, 1, fp);
-    fwrite(&intervals[i][3], 1, 1, fp);
-    fwrite(&intervals[i][4], 1, 1, fp);
+  uint8_t *p;
+  int cols = 0, rows = 0;
+  int count = 0;
+  int slot, b;
+
+  // Number of words: the last word with text or lit at any time
+  uint64_t used = 0;
+  for (slot = 0; slot < LIT_SLOTS; slot++) {
+    used |= table[slot];
   }
-  fclose(fp);
-  return 0;
+  for (i = 1; i < MAX_WORDS; i++) {
+    if (*lang->words[i].text_on || ((used >> i) & 1)) count = i;
+  }
+
+  // Word entries
+  p = &pack[PACK_HEADER_SIZE];
+  for(i = 1; i <= count; i++) {
+    w = &lang->words[i];
+    *p++ = (w->row << 4) | w->col;
+    *p++ = (strlen(w->text_on) << 4) | (is_derived(w) ? 0 : strlen(w->text_off));
+    put_u16(p, *w->text_on ? pool_add(w->text_on) : 0);
+    put_u16(p + 2, is_derived(w) ? TEXT_DERIVED : (*w->text_off ? pool_add(w->text_off) : 0));
+    p += 4;
+    const int width = utf8_length(w->text_on) > utf8_length(w->text_off)
+      ? utf8_length(w->text_on) : utf8_length(w->text_off);
+    *p++ = width;
+    if (*w->text_on) {
+      if (w->row + 1 > rows) rows = w->row + 1;
+      if (w->col + width > cols) cols = w->col + width;
+    }
+  }
+  if (cols > 16) die(lang, NULL, "the grid is wider than 16 columns");
+
+  // Lit-word table
+  for (slot = 0; slot < LIT_SLOTS; slot++) {
+    for (b = 0; b < 8; b++) {
+      *p++ = (uint8_t)(table[slot] >> (b * 8));
+    }
+  }
+  const uint16_t size = p - pack;
+
+  // Header
+  pack[0] = count;
+  pack[1] = cols;
+  pack[2] = rows;
+  pack[3] = PACK_RAW;
+  put_u32(&pack[4], crc32(&pack[PACK_HEADER_SIZE], size - PACK_HEADER_SIZE));
+  return size;
+}
+
+#define LOAD_CHUNK_SIZE 64     /**< Bytes the watch reads at a time from compressed word entries */
+#define LOOKUPS_PER_DAY 576    /**< Lit-word lookups a day with two-minute dots: two per interval */
+#define MIN_BYTES_PER_READ 16  /**< Bytes compression must save for each resource read it adds */
+
+/**
+ * Compress the word entries of a pack if it is worth it, and print its line
+ * of the report.
+ *
+ * Only the entries are ever compressed: they are read once, when the
+ * language is loaded, while the lit-word table is read one entry at a time
+ * on every change of interval and must stay a single read. The choice is
+ * size against resource reads, the cost of either encoding being the reads
+ * of a day with one load: the load reads raw entries at once and compressed
+ * ones LOAD_CHUNK_SIZE bytes at a time, and each of the LOOKUPS_PER_DAY
+ * lookups is one read of the table (the report's raw/day and lz/day).
+ * The entries are compressed if that saves at least MIN_BYTES_PER_READ
+ * bytes for every read it adds. Decoding is not weighed: it is a single
+ * pass over a few hundred bytes, once per load.
+ *
+ * @param raw True to keep the pack raw regardless
+ * @return New size of the pack in bytes
+ */
+static uint16_t choose_encoding(const lang_t *lang, uint8_t *pack, uint16_t size, int raw) {
+  static uint8_t compressed[(MAX_WORDS - 1) * WORD_ENTRY_SIZE * 2];
+  static uint8_t decoded[(MAX_WORDS - 1) * WORD_ENTRY_SIZE];
+  uint8_t *entries = &pack[PACK_HEADER_SIZE];
+  const size_t entries_size = size - PACK_HEADER_SIZE - LIT_TABLE_SIZE;
+  const size_t lz_size = lz_compress(entries, entries_size, compressed);
+  const char *name = strrchr(lang->path, '/');
+
+  if (lz_decompress(compressed, lz_size, decoded, entries_size) != 0 ||
+      memcmp(decoded, entries, entries_size) != 0) {
+    die(lang, NULL, "the compressed word entries do not decode");
+  }
+
+  const int lookup_reads = 1; // Either way, the table is raw
+  const long raw_reads = 1 + (long)LOOKUPS_PER_DAY * lookup_reads;
+  const long lz_reads = (lz_size + LOAD_CHUNK_SIZE - 1) / LOAD_CHUNK_SIZE + (long)LOOKUPS_PER_DAY * lookup_reads;
+  const long saved = (long)entries_size - (long)lz_size;
+  const int compress = !raw && saved > 0 && saved >= MIN_BYTES_PER_READ * (lz_reads - raw_reads);
+  printf("  %-26s %5u %10u %6ld %9ld %9ld  %s\n", name ? name + 1 : lang->path, size,
+    (unsigned)(size - saved), saved, raw_reads, lz_reads, compress ? "compressed" : "raw");
+  if (!compress) return size;
+
+  // The entries shrink in place, and the table moves up after them
+  memmove(&entries[lz_size], &entries[entries_size], LIT_TABLE_SIZE);
+  memcpy(entries, compressed, lz_size);
+  pack[3] = PACK_LZ;
+  return size - saved;
 }
 
+static int usage(void) {
+  fprintf(stderr, "usage: cclp [-r] <output.cclp> <source.json>...\n"
+                  "       cclp -a [-f] [-p <platform>] [-m <directory>] <packs.cclp>...\n");
+  return 1;
+}
+
+int main(int argc, char **argv) {
+  static lang_t langs[MAX_LANGUAGES];
+  static uint64_t tables[MAX_LANGUAGES][LIT_SLOTS];
+  static json_t *roots[MAX_LANGUAGES];
+  static uint8_t packs[BUNDLE_HEADER_SIZE + MAX_LANGUAGES * INDEX_ENTRY_SIZE + sizeof(pool) +
+                       MAX_LANGUAGES * (PACK_HEADER_SIZE + (MAX_WORDS - 1) * WORD_ENTRY_SIZE + LIT_TABLE_SIZE)];
+  FILE *fp;
+  int i, j;
+
+  if (argc >= 2 && strcmp(argv[1], "-a") == 0) {
+    const platform_t *platform = find_platform("aplite");
+    const char *pgm_dir = NULL;
+    int frames = 0, failed = 0;
+    for (i = 2; i + 1 < argc && argv[i][0] == '-'; i++) {
+      if (strcmp(argv[i], "-f") == 0) {
+        frames = 1;
+      } else if (strcmp(argv[i], "-p") == 0) {
+        platform = find_platform(argv[++i]);
+        if (!platform) {
+          fprintf(stderr, "cclp: unknown platform %s\n", argv[i]);
+          return 1;
+        }
+      } else if (strcmp(argv[i], "-m") == 0) {
+        pgm_dir = argv[++i];
+      } else {
+        break;
+      }
+    }
+    if (i >= argc) return usage();
+    for (; i < argc; i++) {
+      failed |= analyze_packs(argv[i], platform, pgm_dir, frames);
+    }
+    return failed;
+  }
+
+  const int raw = argc >= 2 && strcmp(argv[1], "-r") == 0;
+  if (raw) {
+    argv++;
+    argc--;
+  }
+  if (argc < 3) return usage();
+  const int count = argc - 2;
+  if (count > MAX_LANGUAGES) {
+    fprintf(stderr, "cclp: more than %d sources\n", MAX_LANGUAGES);
+    return 1;
+  }
+
+  // Read all the sources first, as their texts share one string pool
+  int index_count = 0;
+  for (i = 0; i < count; i++) {
+    lang_t *lang = &langs[i];
+    roots[i] = load_lang(lang, argv[i + 2]);
+    for (j = 0; j < i; j++) {
+      if (langs[j].language == lang->language) {
+        die(lang, NULL, "language %d is also used by %s", lang->language, langs[j].path);
+      }
+    }
+    if (lang->language + 1 > index_count) index_count = lang->language + 1;
+    lit_table(lang, tables[i]);
+    if (lang->solve_rows) solve_layout(lang, tables[i]);
+  }
+  build_pool(langs, count);
+
+  const uint16_t pool_offset = BUNDLE_HEADER_SIZE + index_count * INDEX_ENTRY_SIZE;
+  uint32_t size = pool_offset + pool_size;
+  uint32_t saved = 0;
+  memset(packs, 0, size);
+  memcpy(&packs[pool_offset], pool, pool_size);
+  printf("  %-26s %5s %10s %6s %9s %9s  %s\n", "source", "raw", "compressed", "saved", "reads/day",
+    "(lz)", "encoding");
+  for (i = 0; i < count; i++) {
+    uint16_t pack_size = build_pack(&langs[i], tables[i], &packs[size]);
+    saved += pack_size;
+    pack_size = choose_encoding(&langs[i], &packs[size], pack_size, raw);
+    saved -= pack_size;
+    uint8_t *entry = &packs[BUNDLE_HEADER_SIZE + langs[i].language * INDEX_ENTRY_SIZE];
+    put_u32(entry, size);
+    put_u16(entry + 4, pack_size);
+    size += pack_size;
+  }
+
+  memcpy(packs, "CCLP", 4);
+  packs[4] = PACK_VERSION;
+  packs[5] = index_count;
+  put_u16(&packs[6], pool_offset);
+  put_u16(&packs[8], pool_size);
+  put_u32(&packs[10], crc32(&packs[pool_offset], pool_size));
+  put_u32(&packs[14], size);
+
+  fp = fopen(argv[1], "wb");
+  if (!fp || fwrite(packs, 1, size, fp) != size || fclose(fp) != 0) {
+    fprintf(stderr, "cclp: cannot write %s\n", argv[1]);
+    return 1;
+  }
+  printf("%s: %d languages, %u bytes (string pool %u bytes, %u bytes saved by compression)\n", argv[1], count,
+         size, pool_size, saved);
+  for (i = 0; i < count; i++) {
+    json_free(roots[i]);
+  }
+  return 0;
+}
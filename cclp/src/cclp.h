@@ -0,0 +1,99 @@
+/**
+ * CCLP - ChronoCode Language Packer
+ *
+ * Types and functions shared by the packer and its layout solver.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#pragma once
+
+#include <stdint.h>
+#include "json.h"
+
+#define PACK_VERSION 6
+#define BUNDLE_HEADER_SIZE 18
+#define INDEX_ENTRY_SIZE 6
+#define PACK_HEADER_SIZE 8
+#define PACK_RAW 0 /**< Encodings of the rest of a pack */
+#define PACK_LZ 1
+#define WORD_ENTRY_SIZE 7
+#define TEXT_DERIVED 0xFFFF
+#define MAX_WORDS 64 /**< Words 0-63, as the lit-word table uses 64-bit bitmaps */
+#define MAX_TEXT 15  /**< Text lengths are stored in 4 bits */
+#define MAX_RULES 32
+#define MAX_LANGUAGES 32 /**< Language IDs 0-31 */
+#define LIT_SLOTS (2 * 12 * 12) /**< Entries in the lit-word table */
+#define LIT_TABLE_SIZE (LIT_SLOTS * 8)
+
+typedef struct {
+  uint8_t row;
+  uint8_t col;
+  char text_on[MAX_TEXT + 1];
+  char text_off[MAX_TEXT + 1];
+  const char *name;
+} word_t;
+
+typedef struct {
+  uint16_t hours;  /**< Bitmap of the hours (bit N is hour N) the rule applies to */
+  uint8_t min_first;
+  uint8_t min_last;
+  uint64_t on;     /**< Words to light */
+  uint64_t off;    /**< Words to turn off */
+} rule_t;
+
+/**
+ * A language pack source.
+ */
+typedef struct {
+  const char *path;
+  uint8_t language;         /**< Language ID, as in the settings (LANG_* in src/chronocode.h) */
+  word_t words[MAX_WORDS];
+  uint64_t defined;         /**< Bitmap of the words defined by the source */
+  uint64_t always_on;       /**< Words lit at all times */
+  uint64_t intervals[13];   /**< Words lit during intervals 1-12 */
+  uint16_t next_hour;       /**< Bitmap of the intervals referring to the next hour */
+  rule_t rules[MAX_RULES];
+  int rule_count;
+  uint8_t order[MAX_WORDS]; /**< The defined words, in the order of the source */
+  int order_count;
+  /** Size of the grid for the layout solver (see solve.h), or 0 if the source places the words */
+  uint8_t solve_rows;
+  uint8_t solve_cols;
+  uint64_t placed;          /**< Words of a "solve" source that still give a row and column */
+} lang_t;
+
+/**
+ * Report an error in a source file and exit.
+ *
+ * @param value The value the error is about, for its line number, or NULL
+ */
+void die(const lang_t *lang, const json_t *value, const char *format, ...);
+
+/**
+ * Count the characters (not bytes) of a UTF-8 string.
+ */
+int utf8_length(const char *text);
+
+/**
+ * Compute the lit-word table of a language: the lit words for every slot,
+ * ordered by the "rounded" flag, then hour (1-12), then interval (1-12).
+ */
+void lit_table(const lang_t *lang, uint64_t *table);
+
+/**
+ * Add the texts of a set of languages to the shared string pool of a packs
+ * file, longest texts first so shorter ones can reuse them.
+ */
+void build_pool(const lang_t *langs, int count);
+
+/**
+ * Build the pack for a language. Its texts must already be in the string
+ * pool (see build_pool()).
+ *
+ * @param table The lit-word table (LIT_SLOTS entries)
+ * @param pack  Buffer for the pack
+ * @return Size of the pack in bytes
+ */
+uint16_t build_pack(const lang_t *lang, const uint64_t *table, uint8_t *pack);
@@ -0,0 +1,244 @@
+/**
+ * Minimal JSON parser for the language pack sources
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "json.h"
+
+typedef struct {
+  const char *p;
+  int line;
+  char *error;
+  int size;
+} parser_t;
+
+static json_t *parse_value(parser_t *ps);
+
+static void fail(parser_t *ps, const char *format, ...) {
+  va_list args;
+  if (ps->error[0]) return; // Keep the first error
+  int n = snprintf(ps->error, ps->size, "line %d: ", ps->line);
+  va_start(args, format);
+  vsnprintf(ps->error + n, ps->size - n, format, args);
+  va_end(args);
+}
+
+static void skip_space(parser_t *ps) {
+  while (*ps->p == ' ' || *ps->p == '\t' || *ps->p == '\r' || *ps->p == '\n') {
+    if (*ps->p == '\n') ps->line++;
+    ps->p++;
+  }
+}
+
+static json_t *new_value(parser_t *ps, json_type_t type) {
+  json_t *value = calloc(1, sizeof(json_t));
+  if (!value) {
+    fprintf(stderr, "cclp: out of memory\n");
+    exit(1);
+  }
+  value->type = type;
+  value->line = ps->line;
+  return value;
+}
+
+/**
+ * Append a code point to a string as UTF-8.
+ */
+static char *put_utf8(char *out, unsigned cp) {
+  if (cp < 0x80) {
+    *out++ = cp;
+  } else if (cp < 0x800) {
+    *out++ = 0xC0 | (cp >> 6);
+    *out++ = 0x80 | (cp & 0x3F);
+  } else {
+    *out++ = 0xE0 | (cp >> 12);
+    *out++ = 0x80 | ((cp >> 6) & 0x3F);
+    *out++ = 0x80 | (cp & 0x3F);
+  }
+  return out;
+}
+
+static char *parse_string(parser_t *ps) {
+  const char *start = ++ps->p; // Skip the opening quote
+  const char *end = start;
+  while (*end && *end != '"') {
+    if (*end == '\\' && end[1]) end++;
+    end++;
+  }
+  if (!*end) {
+    fail(ps, "unterminated string");
+    return NULL;
+  }
+
+  // Unescaping never makes the string longer
+  char *string = malloc(end - start + 1);
+  char *out = string;
+  while (ps->p < end) {
+    char c = *ps->p++;
+    if (c == '\n') {
+      fail(ps, "newline in string");
+    } else if (c != '\\') {
+      *out++ = c;
+      continue;
+    }
+    c = *ps->p++;
+    switch (c) {
+      case '"': case '\\': case '/': *out++ = c; break;
+      case 'b': *out++ = '\b'; break;
+      case 'f': *out++ = '\f'; break;
+      case 'n': *out++ = '\n'; break;
+      case 'r': *out++ = '\r'; break;
+      case 't': *out++ = '\t'; break;
+      case 'u': {
+        unsigned cp;
+        if (sscanf(ps->p, "%4x", &cp) != 1 || cp >= 0xD800) {
+          fail(ps, "unsupported \\u escape");
+          cp = '?';
+        }
+        ps->p += 4;
+        out = put_utf8(out, cp);
+        break;
+      }
+      default:
+        fail(ps, "invalid escape \\%c", c);
+    }
+  }
+  *out = '\0';
+  ps->p = end + 1;
+  return string;
+}
+
+/**
+ * Parse the elements of an array or the members of an object, after the
+ * opening bracket.
+ */
+static json_t *parse_container(parser_t *ps, json_type_t type) {
+  const char close = type == JSON_ARRAY ? ']' : '}';
+  json_t *container = new_value(ps, type);
+  json_t **tail = &container->child;
+  ps->p++;
+  skip_space(ps);
+  if (*ps->p == close) {
+    ps->p++;
+    return container;
+  }
+
+  for (;;) {
+    char *key = NULL;
+    skip_space(ps);
+    if (type == JSON_OBJECT) {
+      if (*ps->p != '"') {
+        fail(ps, "expected a member name");
+        break;
+      }
+      key = parse_string(ps);
+      skip_space(ps);
+      if (*ps->p != ':') {
+        free(key);
+        fail(ps, "expected ':'");
+        break;
+      }
+      ps->p++;
+    }
+    json_t *value = parse_value(ps);
+    if (!value) {
+      free(key);
+      break;
+    }
+    value->key = key;
+    *tail = value;
+    tail = &value->next;
+
+    skip_space(ps);
+    if (*ps->p == ',') {
+      ps->p++;
+    } else if (*ps->p == close) {
+      ps->p++;
+      return container;
+    } else {
+      fail(ps, "expected ',' or '%c'", close);
+      break;
+    }
+  }
+  json_free(container);
+  return NULL;
+}
+
+static json_t *parse_value(parser_t *ps) {
+  json_t *value;
+  skip_space(ps);
+  switch (*ps->p) {
+    case '{':
+      return parse_container(ps, JSON_OBJECT);
+    case '[':
+      return parse_container(ps, JSON_ARRAY);
+    case '"':
+      value = new_value(ps, JSON_STRING);
+      value->string = parse_string(ps);
+      if (!value->string) {
+        json_free(value);
+        return NULL;
+      }
+      return value;
+  }
+  if (strncmp(ps->p, "null", 4) == 0) {
+    ps->p += 4;
+    return new_value(ps, JSON_NULL);
+  }
+  if (strncmp(ps->p, "true", 4) == 0 || strncmp(ps->p, "false", 5) == 0) {
+    value = new_value(ps, JSON_BOOL);
+    value->number = *ps->p == 't';
+    ps->p += value->number ? 4 : 5;
+    return value;
+  }
+  if (*ps->p == '-' || (*ps->p >= '0' && *ps->p <= '9')) {
+    char *end;
+    value = new_value(ps, JSON_NUMBER);
+    value->number = strtod(ps->p, &end);
+    ps->p = end;
+    return value;
+  }
+  fail(ps, *ps->p ? "unexpected '%c'" : "unexpected end of file", *ps->p);
+  return NULL;
+}
+
+json_t *json_parse(const char *text, char *error, int size) {
+  parser_t ps = { text, 1, error, size };
+  error[0] = '\0';
+  json_t *root = parse_value(&ps);
+  if (root) {
+    skip_space(&ps);
+    if (*ps.p) fail(&ps, "unexpected '%c' after the document", *ps.p);
+  }
+  if (error[0]) {
+    json_free(root);
+    return NULL;
+  }
+  return root;
+}
+
+void json_free(json_t *value) {
+  while (value) {
+    json_t *next = value->next;
+    json_free(value->child);
+    free(value->string);
+    free(value->key);
+    free(value);
+    value = next;
+  }
+}
+
+json_t *json_get(const json_t *object, const char *key) {
+  json_t *member;
+  if (!object || object->type != JSON_OBJECT) return NULL;
+  for (member = object->child; member; member = member->next) {
+    if (strcmp(member->key, key) == 0) return member;
+  }
+  return NULL;
+}
@@ -0,0 +1,54 @@
+/**
+ * Minimal JSON parser for the language pack sources
+ *
+ * Parses a whole document into a tree of json_t values. Strings are kept as
+ * UTF-8 (\u escapes are decoded); numbers are doubles.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#pragma once
+
+typedef enum {
+  JSON_NULL,
+  JSON_BOOL,
+  JSON_NUMBER,
+  JSON_STRING,
+  JSON_ARRAY,
+  JSON_OBJECT
+} json_type_t;
+
+typedef struct json json_t;
+
+struct json {
+  json_type_t type;
+  double number;   /**< Value of a number, or 0/1 for a boolean */
+  char *string;    /**< Value of a string */
+  char *key;       /**< Key of an object member */
+  json_t *child;   /**< First element of an array or member of an object */
+  json_t *next;    /**< Next element or member of the parent */
+  int line;        /**< Line on which the value starts, for error messages */
+};
+
+/**
+ * Parse a JSON document.
+ *
+ * @param text  The document, NUL-terminated
+ * @param error Buffer for an error message (with its line number) on failure
+ * @param size  Size of the error buffer
+ * @return The root value, or NULL on error
+ */
+json_t *json_parse(const char *text, char *error, int size);
+
+/**
+ * Free a value returned by json_parse().
+ */
+void json_free(json_t *value);
+
+/**
+ * Get a member of an object.
+ *
+ * @return The member's value, or NULL if the object has no such member
+ */
+json_t *json_get(const json_t *object, const char *key);
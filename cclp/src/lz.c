@@ -0,0 +1,110 @@
+/**
+ * CCLP - ChronoCode Language Packer: pack compression
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <string.h>
+#include "lz.h"
+
+/**
+ * Write the continuation bytes of a token field.
+ */
+static uint8_t *put_length(uint8_t *p, size_t length) {
+  if (length < 15) return p;
+  for (length -= 15; length >= 255; length -= 255) {
+    *p++ = 255;
+  }
+  *p++ = length;
+  return p;
+}
+
+/**
+ * Write a sequence: literals, then a match unless match_length is 0.
+ */
+static uint8_t *put_sequence(uint8_t *p, const uint8_t *literals, size_t count,
+                             size_t match_length, size_t distance) {
+  const size_t match = match_length ? match_length - LZ_MIN_MATCH : 0;
+  *p++ = ((count < 15 ? count : 15) << 4) | (match < 15 ? match : 15);
+  p = put_length(p, count);
+  p = put_length(p, match);
+  memcpy(p, literals, count);
+  p += count;
+  if (match_length) *p++ = distance - 1;
+  return p;
+}
+
+size_t lz_compress(const uint8_t *data, size_t size, uint8_t *out) {
+  uint8_t *p = out;
+  size_t literals = 0;
+  size_t i = 0;
+
+  while (i < size) {
+    // Longest match within the window, preferring the nearest
+    size_t best = 0, best_distance = 0, distance;
+    for (distance = 1; distance <= LZ_WINDOW_SIZE && distance <= i; distance++) {
+      size_t length = 0;
+      while (i + length < size && data[i + length] == data[i + length - distance]) {
+        length++;
+      }
+      if (length > best) {
+        best = length;
+        best_distance = distance;
+      }
+    }
+
+    if (best >= LZ_MIN_MATCH) {
+      p = put_sequence(p, &data[literals], i - literals, best, best_distance);
+      i += best;
+      literals = i;
+    } else {
+      i++;
+    }
+  }
+  if (literals < size) p = put_sequence(p, &data[literals], size - literals, 0, 0);
+  return p - out;
+}
+
+/**
+ * Read the continuation bytes of a token field.
+ *
+ * @return 0 on success, or -1 if the data ends first
+ */
+static int get_length(const uint8_t **p, const uint8_t *end, size_t *length) {
+  if (*length < 15) return 0;
+  for (;;) {
+    if (*p == end) return -1;
+    const uint8_t b = *(*p)++;
+    *length += b;
+    if (b < 255) return 0;
+  }
+}
+
+int lz_decompress(const uint8_t *data, size_t size, uint8_t *out, size_t out_size) {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  size_t pos = 0;
+
+  while (pos < out_size) {
+    if (p == end) return -1;
+    const uint8_t token = *p++;
+    size_t count = token >> 4;
+    size_t match = token & 0x0F;
+    if (get_length(&p, end, &count) || get_length(&p, end, &match)) return -1;
+    if (count > (size_t)(end - p) || count > out_size - pos) return -1;
+    memcpy(&out[pos], p, count);
+    p += count;
+    pos += count;
+    if (pos == out_size) break;
+
+    if (p == end) return -1;
+    const size_t distance = *p++ + 1;
+    match += LZ_MIN_MATCH;
+    if (distance > pos || match > out_size - pos) return -1;
+    for (; match > 0; match--, pos++) {
+      out[pos] = out[pos - distance];
+    }
+  }
+  return p == end ? 0 : -1;
+}
@@ -0,0 +1,48 @@
+/**
+ * CCLP - ChronoCode Language Packer: pack compression
+ *
+ * A byte-oriented LZ77 in the style of LZ4, small enough for the watch to
+ * decode while streaming the pack from its resource (see src/pack_reader.c)
+ * with no more memory than a 128-byte window of the decoded data.
+ *
+ * The compressed data is a series of sequences, each of:
+ *
+ *   uint8  token: (number of literals << 4) | (match length - 3); a field of
+ *          15 is continued by the bytes that follow the token, literals
+ *          first, each added to it until one is less than 255
+ *   ..     the literals
+ *   uint8  match distance - 1 (distances 1-128), then copy the match from
+ *          that far back in the decoded data
+ *
+ * The last sequence may end after its literals, as the decoded size is known
+ * from the pack.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LZ_WINDOW_SIZE 128 /**< Longest match distance */
+#define LZ_MIN_MATCH 3
+
+/**
+ * Compress a block of data.
+ *
+ * @param out Buffer for the compressed data, of at least size + size / 15 + 1 bytes
+ * @return Size of the compressed data in bytes
+ */
+size_t lz_compress(const uint8_t *data, size_t size, uint8_t *out);
+
+/**
+ * Decompress a block of data.
+ *
+ * @param size     Size of the compressed data
+ * @param out      Buffer for the decompressed data
+ * @param out_size Size of the decompressed data
+ * @return 0 on success, or -1 if the data is invalid
+ */
+int lz_decompress(const uint8_t *data, size_t size, uint8_t *out, size_t out_size);
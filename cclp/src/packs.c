@@ -0,0 +1,65 @@
+/**
+ * CCLP - ChronoCode Language Packer: packs file reader
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <stdio.h>
+#include <string.h>
+#include "lz.h"
+#include "packs.h"
+
+uint16_t get_u16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+
+uint32_t get_u32(const uint8_t *p) {
+  return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+size_t read_packs(const char *prog, const char *path, uint8_t *packs, size_t max) {
+  FILE *fp = fopen(path, "rb");
+  size_t size = 0;
+
+  if (fp) {
+    size = fread(packs, 1, max, fp);
+    fclose(fp);
+  }
+  if (!fp || size < BUNDLE_HEADER_SIZE || memcmp(packs, "CCLP", 4) != 0 || packs[4] != PACK_VERSION ||
+      get_u32(&packs[14]) != size || BUNDLE_HEADER_SIZE + packs[5] * INDEX_ENTRY_SIZE > size ||
+      get_u16(&packs[6]) >= size) {
+    fprintf(stderr, "%s: %s: not a packs file (version %d)\n", prog, path, PACK_VERSION);
+    return 0;
+  }
+  return size;
+}
+
+int get_pack(const char *prog, const char *path, const uint8_t *packs, size_t size, int language,
+             uint8_t *unpacked, const uint8_t **pack) {
+  const uint8_t *entry = &packs[BUNDLE_HEADER_SIZE + language * INDEX_ENTRY_SIZE];
+  const uint32_t offset = get_u32(entry);
+  const uint16_t pack_size = get_u16(&entry[4]);
+  const uint8_t *p = &packs[offset];
+
+  *pack = NULL;
+  if (!pack_size) return 0;
+  if (offset + pack_size > size || pack_size < PACK_HEADER_SIZE + LIT_TABLE_SIZE || p[0] >= MAX_WORDS) {
+    fprintf(stderr, "%s: %s: language %d is out of range\n", prog, path, language);
+    return 1;
+  }
+  if (p[3] == PACK_LZ) {
+    memcpy(unpacked, p, PACK_HEADER_SIZE);
+    if (lz_decompress(&p[PACK_HEADER_SIZE], pack_size - PACK_HEADER_SIZE - LIT_TABLE_SIZE,
+                      &unpacked[PACK_HEADER_SIZE], p[0] * WORD_ENTRY_SIZE) != 0) {
+      fprintf(stderr, "%s: %s: language %d does not decode\n", prog, path, language);
+      return 1;
+    }
+    p = unpacked;
+  } else if (PACK_HEADER_SIZE + p[0] * WORD_ENTRY_SIZE + LIT_TABLE_SIZE != pack_size) {
+    fprintf(stderr, "%s: %s: language %d is out of range\n", prog, path, language);
+    return 1;
+  }
+  *pack = p;
+  return 0;
+}
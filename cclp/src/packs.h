@@ -0,0 +1,46 @@
+/**
+ * CCLP - ChronoCode Language Packer: packs file reader
+ *
+ * Reads a packs file (see cclp.c) for the tools that work from one, the
+ * overdraw analyzer and the glyph atlas generator, checking that every pack
+ * they read lies within the file and decoding compressed word entries.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cclp.h"
+
+/** Size of a pack's header and word entries, as returned by get_pack() */
+#define UNPACKED_SIZE (PACK_HEADER_SIZE + (MAX_WORDS - 1) * WORD_ENTRY_SIZE)
+
+uint16_t get_u16(const uint8_t *p);
+uint32_t get_u32(const uint8_t *p);
+
+/**
+ * Read a packs file and check its header and index.
+ *
+ * @param prog  Name of the program, for the error messages
+ * @param packs Buffer for the file
+ * @param max   Size of the buffer
+ * @return Size of the file, or 0 if it cannot be read or is not a packs file (the error is reported)
+ */
+size_t read_packs(const char *prog, const char *path, uint8_t *packs, size_t max);
+
+/**
+ * Get the pack of a language from a packs file read by read_packs(), with
+ * its word entries decoded if they are compressed. The sizes of the pack's
+ * sections must add up to the size of the pack.
+ *
+ * @param language Language ID
+ * @param unpacked Buffer of UNPACKED_SIZE bytes for the decoded pack
+ * @param pack     Set to the header and word entries of the pack, or NULL
+ *                 if the file has no pack for the language
+ * @return 0 on success, or 1 if the pack is invalid (the error is reported)
+ */
+int get_pack(const char *prog, const char *path, const uint8_t *packs, size_t size, int language,
+             uint8_t *unpacked, const uint8_t **pack);
@@ -0,0 +1,464 @@
+/**
+ * CCLP - ChronoCode Language Packer: grid layout solver
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#define _DEFAULT_SOURCE // sysconf(_SC_NPROCESSORS_ONLN)
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "solve.h"
+
+#define SOLVE_SEARCHES 32   /**< Independent searches, of which the best layout is kept */
+#define SOLVE_STEPS 100000  /**< Annealing steps per search */
+#define TEMP_START 2000.0
+#define TEMP_END 1.0
+
+#define COST_CONFLICT 1000  /**< Per cell by which words clash or are out of order */
+#define COST_LAYER 100
+#define COST_SPLIT 30       /**< Per word split into several layers */
+#define COST_FILLER 1       /**< Per filler letter */
+
+#define MAX_CELLS 16
+
+/**
+ * The words to lay out, numbered in reading order.
+ */
+typedef struct {
+  const lang_t *lang;
+  int rows;
+  int cols;
+  int n;
+  uint8_t index[MAX_WORDS];           /**< Source word */
+  uint8_t width[MAX_WORDS];
+  uint32_t on[MAX_WORDS][MAX_CELLS];  /**< UTF-8 bytes of each character of text_on */
+  uint32_t off[MAX_WORDS][MAX_CELLS]; /**< UTF-8 bytes of each character of text_off */
+  uint64_t together[MAX_WORDS];       /**< Words lit at the same time as each word */
+  uint64_t lit[LIT_SLOTS];            /**< Lit-word table */
+} problem_t;
+
+typedef struct {
+  uint8_t row[MAX_WORDS];
+  uint8_t col[MAX_WORDS];
+} layout_t;
+
+typedef struct {
+  int conflicts;
+  int layers;
+  int splits;
+  int fillers;
+  long cost;
+} score_t;
+
+/**
+ * State shared by the search threads.
+ */
+typedef struct {
+  const problem_t *problem;
+  pthread_mutex_t lock;
+  int next;         /**< Next search to run */
+  int best_search;  /**< Search that found the best layout, or -1 */
+  layout_t best;
+  score_t best_score;
+} search_t;
+
+/**
+ * Split a UTF-8 string into characters.
+ *
+ * @return Number of characters
+ */
+static int split_chars(const char *text, uint32_t *chars) {
+  int n = 0;
+  for (; *text; text++) {
+    if ((*text & 0xC0) != 0x80) {
+      chars[n++] = (uint8_t)*text;
+    } else {
+      chars[n - 1] = (chars[n - 1] << 8) | (uint8_t)*text;
+    }
+  }
+  return n;
+}
+
+static char *put_chars(char *out, const uint32_t *chars, int n) {
+  int i, shift;
+  for (i = 0; i < n; i++) {
+    for (shift = 24; shift > 0 && !(chars[i] >> shift); shift -= 8);
+    for (; shift >= 0; shift -= 8) *out++ = chars[i] >> shift;
+  }
+  *out = '\0';
+  return out;
+}
+
+/**
+ * xorshift32; the searches must not depend on the C library's generator.
+ */
+static uint32_t next_random(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+/**
+ * Compute which words cover each cell of a layout.
+ */
+static void cover_cells(const problem_t *pb, const layout_t *lo, uint64_t cover[MAX_CELLS][MAX_CELLS]) {
+  int i, k;
+  memset(cover, 0, sizeof(uint64_t) * MAX_CELLS * MAX_CELLS);
+  for (i = 0; i < pb->n; i++) {
+    for (k = 0; k < pb->width[i]; k++) {
+      cover[lo->row[i]][lo->col[i] + k] |= (uint64_t)1 << i;
+    }
+  }
+}
+
+/**
+ * Get the length of the layer starting at a cell: the cells after it covered
+ * by the same words, or the empty cells after it.
+ */
+static int layer_length(const problem_t *pb, uint64_t cover[MAX_CELLS][MAX_CELLS], int row, int col) {
+  int len = 1;
+  while (col + len < pb->cols && cover[row][col + len] == cover[row][col] &&
+         (cover[row][col] || len < MAX_TEXT)) {
+    len++;
+  }
+  return len;
+}
+
+static score_t evaluate(const problem_t *pb, const layout_t *lo) {
+  score_t s = { 0, 0, 0, 0, 0 };
+  uint64_t cover[MAX_CELLS][MAX_CELLS];
+  int i, j, k, row, col;
+
+  for (i = 0; i < pb->n; i++) {
+    const int end_i = lo->col[i] + pb->width[i];
+    for (j = i + 1; j < pb->n; j++) {
+      const int end_j = lo->col[j] + pb->width[j];
+      if ((pb->together[i] >> j) & 1) {
+        // j must follow i, with a space between them on the same row; the
+        // conflict grows with the distance j would have to move
+        const int need = lo->row[i] * pb->cols + end_i + 1;
+        const int at = lo->row[j] * pb->cols + lo->col[j];
+        if (lo->row[j] <= lo->row[i] && at < need) s.conflicts += need - at;
+      } else if (lo->row[i] == lo->row[j]) {
+        // Words never lit together can share the cells where they have the same letters
+        const int first = lo->col[i] > lo->col[j] ? lo->col[i] : lo->col[j];
+        const int last = end_i < end_j ? end_i : end_j;
+        for (k = first; k < last; k++) {
+          if (pb->on[i][k - lo->col[i]] != pb->on[j][k - lo->col[j]] ||
+              pb->off[i][k - lo->col[i]] != pb->off[j][k - lo->col[j]]) {
+            s.conflicts++;
+          }
+        }
+      }
+    }
+  }
+
+  cover_cells(pb, lo, cover);
+  for (row = 0; row < pb->rows; row++) {
+    for (col = 0; col < pb->cols; col += k) {
+      k = layer_length(pb, cover, row, col);
+      s.layers++;
+      if (!cover[row][col]) s.fillers += k;
+    }
+  }
+  for (i = 0; i < pb->n; i++) {
+    for (k = 1; k < pb->width[i]; k++) {
+      if (cover[lo->row[i]][lo->col[i] + k] != cover[lo->row[i]][lo->col[i]]) {
+        s.splits++;
+        break;
+      }
+    }
+  }
+
+  s.cost = (long)s.conflicts * COST_CONFLICT + s.layers * COST_LAYER +
+    s.splits * COST_SPLIT + s.fillers * COST_FILLER;
+  return s;
+}
+
+/**
+ * Compare layouts: any layout without conflicts beats any layout with them.
+ */
+static int better(const score_t *a, const score_t *b) {
+  if ((a->conflicts == 0) != (b->conflicts == 0)) return a->conflicts == 0;
+  return a->cost < b->cost;
+}
+
+static void random_position(const problem_t *pb, layout_t *lo, int i, uint32_t *rnd) {
+  lo->row[i] = next_random(rnd) % pb->rows;
+  lo->col[i] = next_random(rnd) % (pb->cols - pb->width[i] + 1);
+}
+
+/**
+ * Move word i to share one of its letters with word j, if they are never lit
+ * together and have a letter in common.
+ */
+static void overlap(const problem_t *pb, layout_t *lo, int i, int j, uint32_t *rnd) {
+  int k, m, col, found = 0;
+  if (i == j || ((pb->together[i] >> j) & 1)) return;
+  for (k = 0; k < pb->width[i]; k++) {
+    for (m = 0; m < pb->width[j]; m++) {
+      col = lo->col[j] + m - k;
+      if (pb->on[i][k] != pb->on[j][m] || pb->off[i][k] != pb->off[j][m] ||
+          col < 0 || col + pb->width[i] > pb->cols) {
+        continue;
+      }
+      // Pick one of the matches at random
+      if (next_random(rnd) % ++found == 0) {
+        lo->row[i] = lo->row[j];
+        lo->col[i] = col;
+      }
+    }
+  }
+}
+
+/**
+ * Run one search.
+ *
+ * @param seed Seed of the search, so that each search is repeatable
+ */
+static void anneal(const problem_t *pb, int seed, layout_t *best, score_t *best_score) {
+  uint32_t rnd = 0x9E3779B9u * (seed + 1);
+  const double cooling = pow(TEMP_END / TEMP_START, 1.0 / SOLVE_STEPS);
+  double temp = TEMP_START;
+  layout_t cur, next;
+  score_t cur_score, next_score;
+  int step, i, j;
+
+  for (i = 0; i < pb->n; i++) {
+    random_position(pb, &cur, i, &rnd);
+  }
+  cur_score = evaluate(pb, &cur);
+  *best = cur;
+  *best_score = cur_score;
+
+  for (step = 0; step < SOLVE_STEPS; step++, temp *= cooling) {
+    next = cur;
+    i = next_random(&rnd) % pb->n;
+    j = next_random(&rnd) % pb->n;
+    switch (next_random(&rnd) % 6) {
+      case 0:
+        random_position(pb, &next, i, &rnd);
+        break;
+      case 1:
+        // Nudge along the row
+        if (next_random(&rnd) & 1) {
+          if (next.col[i] > 0) next.col[i]--;
+        } else if (next.col[i] + pb->width[i] < pb->cols) {
+          next.col[i]++;
+        }
+        break;
+      case 2:
+        // Move to another row
+        next.row[i] = next_random(&rnd) % pb->rows;
+        break;
+      case 3:
+        // Swap rows with another word
+        next.row[i] = cur.row[j];
+        next.row[j] = cur.row[i];
+        if (next.col[i] + pb->width[i] > pb->cols) next.col[i] = pb->cols - pb->width[i];
+        if (next.col[j] + pb->width[j] > pb->cols) next.col[j] = pb->cols - pb->width[j];
+        break;
+      case 4:
+        // Place right after another word
+        if (cur.col[j] + pb->width[j] + pb->width[i] <= pb->cols) {
+          next.row[i] = cur.row[j];
+          next.col[i] = cur.col[j] + pb->width[j];
+        }
+        break;
+      default:
+        // Share a letter with another word
+        overlap(pb, &next, i, j, &rnd);
+    }
+
+    next_score = evaluate(pb, &next);
+    const long delta = next_score.cost - cur_score.cost;
+    if (delta <= 0 || next_random(&rnd) < exp(-delta / temp) * 4294967295.0) {
+      cur = next;
+      cur_score = next_score;
+      if (better(&cur_score, best_score)) {
+        *best = cur;
+        *best_score = cur_score;
+      }
+    }
+  }
+}
+
+static void *search_thread(void *arg) {
+  search_t *search = arg;
+  layout_t layout;
+  score_t score;
+  int seed;
+
+  for (;;) {
+    pthread_mutex_lock(&search->lock);
+    seed = search->next++;
+    pthread_mutex_unlock(&search->lock);
+    if (seed >= SOLVE_SEARCHES) return NULL;
+
+    anneal(search->problem, seed, &layout, &score);
+
+    // Keep the best layout, preferring the lowest seed so the result does
+    // not depend on the order the searches finish in
+    pthread_mutex_lock(&search->lock);
+    if (search->best_search < 0 || better(&score, &search->best_score) ||
+        (!better(&search->best_score, &score) && seed < search->best_search)) {
+      search->best_search = seed;
+      search->best = layout;
+      search->best_score = score;
+    }
+    pthread_mutex_unlock(&search->lock);
+  }
+}
+
+/**
+ * Collect the words to lay out: those with text that are lit at some time.
+ * Words that are never lit are fillers, which the layout makes its own.
+ */
+static void init_problem(problem_t *pb, const lang_t *lang, const uint64_t *table) {
+  uint64_t used = 0;
+  int i, slot;
+
+  memset(pb, 0, sizeof(*pb));
+  pb->lang = lang;
+  pb->rows = lang->solve_rows;
+  pb->cols = lang->solve_cols;
+  for (slot = 0; slot < LIT_SLOTS; slot++) {
+    used |= table[slot];
+  }
+
+  for (i = 0; i < lang->order_count; i++) {
+    const int index = lang->order[i];
+    const word_t *w = &lang->words[index];
+    if (!*w->text_on || !((used >> index) & 1)) continue;
+    pb->index[pb->n] = index;
+    pb->width[pb->n] = split_chars(w->text_on, pb->on[pb->n]);
+    if (split_chars(w->text_off, pb->off[pb->n]) != pb->width[pb->n]) {
+      die(lang, NULL, "\"%s\" and \"%s\" differ in length", w->text_on, w->text_off);
+    }
+    if (pb->width[pb->n] > pb->cols) {
+      die(lang, NULL, "\"%s\" is wider than the grid", w->text_on);
+    }
+    pb->n++;
+  }
+  if (!pb->n) die(lang, NULL, "no words to lay out");
+
+  // Renumber the lit-word table for the words being laid out
+  for (slot = 0; slot < LIT_SLOTS; slot++) {
+    for (i = 0; i < pb->n; i++) {
+      if ((table[slot] >> pb->index[i]) & 1) pb->lit[slot] |= (uint64_t)1 << i;
+    }
+    for (i = 0; i < pb->n; i++) {
+      if ((pb->lit[slot] >> i) & 1) pb->together[i] |= pb->lit[slot];
+    }
+  }
+  for (i = 0; i < pb->n; i++) {
+    pb->together[i] &= ~((uint64_t)1 << i);
+  }
+}
+
+/**
+ * Choose a filler letter for a cell. Any letter will do, as long as the
+ * same layout always gets the same letters.
+ */
+static uint32_t filler_letter(int row, int col) {
+  return 'A' + ((uint32_t)(row * MAX_CELLS + col + 1) * 2654435761u >> 16) % 26;
+}
+
+void solve_layout(lang_t *lang, uint64_t *table) {
+  static problem_t pb;
+  search_t search;
+  uint64_t cover[MAX_CELLS][MAX_CELLS];
+  uint64_t masks[MAX_WORDS];
+  pthread_t threads[64];
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  int i, n, row, col, len, slot;
+
+  init_problem(&pb, lang, table);
+
+  if (cores < 1) cores = 1;
+  if (cores > 64) cores = 64;
+  memset(&search, 0, sizeof(search));
+  search.problem = &pb;
+  search.best_search = -1;
+  pthread_mutex_init(&search.lock, NULL);
+  for (i = 0; i < cores; i++) {
+    if (pthread_create(&threads[i], NULL, search_thread, &search) != 0) {
+      die(lang, NULL, "cannot start the search threads");
+    }
+  }
+  for (i = 0; i < cores; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  pthread_mutex_destroy(&search.lock);
+
+  const layout_t *lo = &search.best;
+  const score_t *s = &search.best_score;
+  if (s->conflicts) {
+    die(lang, NULL, "found no layout of the words in %d rows of %d columns", pb.rows, pb.cols);
+  }
+  if (s->layers >= MAX_WORDS) {
+    die(lang, NULL, "the best layout needs %d layers, more than %d", s->layers, MAX_WORDS - 1);
+  }
+
+  // Replace the words with the layers, in reading order
+  cover_cells(&pb, lo, cover);
+  memset(lang->words, 0, sizeof(lang->words));
+  for (n = 0, row = 0; row < pb.rows; row++) {
+    for (col = 0; col < pb.cols; col += len, n++) {
+      word_t *w = &lang->words[n + 1];
+      uint32_t on[MAX_CELLS], off[MAX_CELLS];
+      len = layer_length(&pb, cover, row, col);
+      masks[n] = cover[row][col];
+      if (masks[n]) {
+        // Any of the words covering the cells has the letters
+        for (i = 0; !((masks[n] >> i) & 1); i++);
+        memcpy(on, &pb.on[i][col - lo->col[i]], len * sizeof(uint32_t));
+        memcpy(off, &pb.off[i][col - lo->col[i]], len * sizeof(uint32_t));
+      } else {
+        for (i = 0; i < len; i++) {
+          on[i] = filler_letter(row, col + i);
+          off[i] = on[i] - 'A' + 'a';
+        }
+      }
+      w->row = row;
+      w->col = col;
+      put_chars(w->text_on, on, len);
+      put_chars(w->text_off, off, len);
+    }
+  }
+  lang->order_count = 0;
+
+  // A layer is lit when any of its words is
+  for (slot = 0; slot < LIT_SLOTS; slot++) {
+    table[slot] = 0;
+    for (i = 0; i < n; i++) {
+      if (masks[i] & pb.lit[slot]) table[slot] |= (uint64_t)1 << (i + 1);
+    }
+  }
+
+  printf("%s: %d words in %d layers, %d split, %d filler letters\n",
+    lang->path, pb.n, s->layers, s->splits, s->fillers);
+  printf("  ");
+  for (col = 0; col < pb.cols; col++) printf("%x", col);
+  printf("\n");
+  for (row = 0; row < pb.rows; row++) {
+    char text[4 * MAX_CELLS + 1];
+    printf("%x ", row);
+    for (col = 0; col < pb.cols; col++) {
+      uint32_t c;
+      for (i = 0; i < pb.n && !((cover[row][col] >> i) & 1); i++);
+      // Filler letters in lowercase
+      c = i < pb.n ? pb.on[i][col - lo->col[i]] : filler_letter(row, col) - 'A' + 'a';
+      put_chars(text, &c, 1);
+      printf("%s", text);
+    }
+    printf("\n");
+  }
+}
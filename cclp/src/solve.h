@@ -0,0 +1,33 @@
+/**
+ * CCLP - ChronoCode Language Packer: grid layout solver
+ *
+ * Lays out the words of a language pack source that has a "solve" member
+ * instead of taking their positions from the source. The order of the words
+ * in the source is their reading order: words that are lit together must
+ * appear in that order, with a space between them when they share a row.
+ * Words that are never lit together may touch, or overlap where their
+ * letters are the same; a shared part becomes a layer of its own, lit when
+ * any of its words is. The cells left over are filled with filler letters.
+ *
+ * The search minimizes, in order of weight, the number of layers (each is a
+ * text layer on the watch), the number of words split into several layers
+ * and the number of filler letters. It runs a number of independent
+ * simulated annealing searches on all the host's cores and keeps the best
+ * layout; the result does not depend on the number of cores.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#pragma once
+
+#include <stdint.h>
+#include "cclp.h"
+
+/**
+ * Lay out the words of a language and replace them with the layers of the
+ * layout, then print the layout as an ASCII map.
+ *
+ * @param table The lit-word table of the language, rewritten for the layers
+ */
+void solve_layout(lang_t *lang, uint64_t *table);
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+"""
+Generate the resource and message key headers that the Pebble SDK would
+normally produce, so that chronocode.c can be built against the host stubs.
+
+Usage: gen_ids.py <package.json> <output directory>
+"""
+import json
+import os
+import sys
+
+def main():
+    package_path, out_dir = sys.argv[1], sys.argv[2]
+    with open(package_path) as f:
+        pebble = json.load(f)['pebble']
+
+    media = pebble['resources']['media']
+    lines = ['#pragma once', '', '// Generated by gen_ids.py from package.json', '']
+    lines.append('typedef enum {')
+    lines.append('  INVALID_RESOURCE = 0,')
+    lines.append('  DEFAULT_MENU_ICON = 0,')
+    for i, m in enumerate(media):
+        lines.append('  RESOURCE_ID_{} = {},'.format(m['name'], i + 1))
+    lines.append('} ResourceId;')
+    lines.append('')
+    lines.append('#define STUB_RESOURCE_COUNT {}'.format(len(media) + 1))
+    lines.append('#define STUB_RESOURCE_TABLE \\')
+    lines.append('  { NULL, NULL, NULL }, \\')
+    for m in media:
+        lines.append('  {{ "{}", "{}", "{}" }}, \\'.format(m['name'], m['type'], m['file']))
+    lines.append('  /* end of table */')
+    lines.append('')
+    with open(os.path.join(out_dir, 'resource_ids.auto.h'), 'w') as f:
+        f.write('\n'.join(lines))
+
+    keys = pebble.get('messageKeys', {})
+    lines = ['#pragma once', '', '// Generated by gen_ids.py from package.json', '']
+    for name, value in sorted(keys.items(), key=lambda kv: kv[1]):
+        lines.append('#define MESSAGE_KEY_{} {}'.format(name, value))
+    lines.append('')
+    with open(os.path.join(out_dir, 'message_keys.auto.h'), 'w') as f:
+        f.write('\n'.join(lines))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,111 @@
+/**
+ * Driver-side interface to the host Pebble stubs.
+ *
+ * Lets a host program control the clock, deliver ticks and AppMessages,
+ * render the window into the fake framebuffer and read back counters.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ */
+#pragma once
+
+#include <pebble.h>
+
+/**
+ * A glyph drawn during the last call to stub_render().
+ */
+typedef struct {
+  int16_t x;          /**< Left edge of the glyph cell, in screen pixels */
+  int16_t y;          /**< Top edge of the text line, in screen pixels */
+  uint32_t codepoint; /**< Unicode code point of the glyph */
+  bool bold;          /**< True if drawn with a "Black" (heavy) font */
+  GColor color;       /**< Text color the glyph was drawn with */
+} StubGlyph;
+
+/**
+ * Counters accumulated by the stubs since the last stub_stats_reset().
+ */
+typedef struct {
+  unsigned text_layer_set_text;       /**< Calls to text_layer_set_text() */
+  unsigned text_layer_set_font;       /**< Calls to text_layer_set_font() */
+  unsigned text_layer_set_text_color; /**< Calls to text_layer_set_text_color() */
+  unsigned layer_mark_dirty;          /**< Calls to layer_mark_dirty() */
+  unsigned layers_created;            /**< Layers and text layers created */
+  unsigned layers_destroyed;          /**< Layers and text layers destroyed */
+  unsigned dirty_layers;              /**< Distinct dirty layers seen by stub_render() */
+  unsigned long pixels_redrawn;       /**< Screen pixels covered by dirty layers */
+  unsigned frames_rendered;           /**< Calls to stub_render() that drew something */
+  unsigned update_procs;              /**< Layer update procs invoked */
+  unsigned glyphs_drawn;              /**< Glyphs rasterized */
+  unsigned resource_reads;            /**< Calls to resource_load()/resource_load_byte_range() */
+  unsigned long resource_bytes;       /**< Bytes read from resources */
+  unsigned persist_writes;            /**< Calls to persist_write_*() */
+  unsigned fonts_loaded;              /**< Calls to fonts_load_custom_font() */
+  unsigned app_logs;                  /**< Calls to app_log() */
+  unsigned app_messages_sent;         /**< Calls to app_message_outbox_send() */
+  unsigned long app_message_bytes;    /**< Bytes written to outgoing AppMessages */
+} StubStats;
+
+extern StubStats stub_stats;
+
+/** Zero all counters in stub_stats. */
+void stub_stats_reset(void);
+
+/** Read a resource from the given file instead of the resource directory. */
+void stub_set_resource_file(uint32_t resource_id, const char *path);
+
+/** Make the allocation after the next `n` fail, once (a negative `n` cancels it). */
+void stub_fail_allocation(int n);
+
+/** Directory containing the package resources (defaults to "../resources"). */
+void stub_set_resource_dir(const char *dir);
+
+/** Print APP_LOG output to stderr when true (default false). */
+void stub_set_log_output(bool enabled);
+
+/** Set the wall clock returned by time() and localtime() (UTC is used as local time). */
+void stub_set_time(time_t now);
+
+/** Deliver a tick to the subscribed tick handler, as if the clock reached `now`. */
+void stub_tick(time_t now);
+
+/** Hook called from app_event_loop(); the driver runs its scenario from here. */
+void stub_set_event_loop(void (*loop)(void));
+
+/** Deliver a tap to the subscribed accelerometer tap handler, if any. */
+void stub_tap(void);
+
+/** Deliver an AppMessage containing the given int32 tuples to the inbox handler. */
+void stub_send_message(const uint32_t *keys, const int32_t *values, size_t count);
+
+/** Remove all persisted keys. */
+void stub_persist_clear(void);
+
+/**
+ * Redraw dirty layers into the framebuffer.
+ *
+ * Like the Pebble compositor, the whole window is re-rendered whenever any
+ * layer is dirty. Dirty statistics are accumulated in stub_stats.
+ *
+ * @return True if anything was dirty and a frame was drawn
+ */
+bool stub_render(void);
+
+/** Framebuffer of PBL_DISPLAY_WIDTH x PBL_DISPLAY_HEIGHT pixels, row-major. */
+const GColor *stub_framebuffer(void);
+
+/** FNV-1a hash of the current framebuffer. */
+uint32_t stub_framebuffer_hash(void);
+
+/**
+ * Record a glyph drawn into a captured frame buffer rather than with
+ * graphics_draw_text() (e.g. blitted from a glyph atlas) as a glyph of the
+ * current frame, with its cell at `origin` (screen pixels).
+ */
+void stub_record_glyph(GPoint origin, uint32_t codepoint, bool bold, GColor color);
+
+/** Glyphs drawn by the last frame, in drawing order. */
+const StubGlyph *stub_glyphs(size_t *count);
+
+/** Number of live layers (including text layers and window root layers). */
+unsigned stub_live_layers(void);
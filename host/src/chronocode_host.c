@@ -0,0 +1,585 @@
+/**
+ * Headless host driver for the ChronoCode watchface.
+ *
+ * Builds src/chronocode.c unmodified against the host Pebble stubs and runs
+ * it through simulated days.
+ *
+ * Usage:
+ *   chronocode_host dump <language id> [two-minute dots] [all caps] [inverted]
+ *     Print the frame hash and lit phrase of every minute of a day.
+ *   chronocode_host check
+ *     Run every language through a day in every combination of settings and
+ *     check that a phrase is shown every minute, and still is when memory
+ *     runs out while switching language, that the app releases all of its
+ *     layers and heap on exit and that settings are only written to
+ *     persistent storage when they change (and, with PERF_INSTRUMENTATION,
+ *     that a tap sends the measurements; with GLYPH_ATLAS_RENDERER, that
+ *     the words are blitted from the atlas without touching the pixels
+ *     around them, their phrase being read back from the frame buffer).
+ *   chronocode_host golden [<packs file> <language id>...]
+ *     Print the golden output for every language in both two-minute dots
+ *     modes: each run of minutes that shows the same phrase, with a hash of
+ *     all of their frames (see golden/). Given a packs file, print it for
+ *     the given languages of that file instead (e.g. a solved layout).
+ *   chronocode_host frames
+ *     Print the frame of every word with text of every language, one per
+ *     line: language, word number, x, y, width and height, as `cclp -a -f`
+ *     does from the packs (make test compares the two).
+ *   chronocode_host bench [days]
+ *     Time the minute tick and the redraw it causes for every language and
+ *     combination of settings over the given number of days (default 1), and
+ *     report the per-tick work done through the Pebble API.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ */
+#include "stub.h"
+#include "chronocode.h"
+
+#ifdef GLYPH_ATLAS_RENDERER
+#include "glyph_atlas.h"
+
+#define MAX_ATLAS_GLYPHS 256
+#define MAX_ATLAS_CELL (16 * 32)
+
+/**
+ * The atlas resource, read here apart from glyph_atlas.c (see
+ * cclp/src/ccga.c for its format), with the coverage level (0-3) of every
+ * pixel of every cell.
+ */
+static struct {
+  int cell_w;
+  int cell_h;
+  int count;
+  uint32_t codepoints[MAX_ATLAS_GLYPHS];
+  uint8_t weights[MAX_ATLAS_GLYPHS];
+  uint8_t levels[MAX_ATLAS_GLYPHS][MAX_ATLAS_CELL];
+} s_atlas;
+static int s_blit_errors; /**< Pixels blitted outside the cells of the text */
+
+static void prv_atlas_load(void) {
+  static uint8_t data[1 << 16];
+  ResHandle rh = resource_get_handle(RESOURCE_ID_GLYPH_ATLAS);
+  resource_load(rh, data, sizeof(data));
+  const int bpp = data[5];
+  const int count = data[8] | (data[9] << 8);
+  const int cell_size = data[10] | (data[11] << 8);
+  s_atlas.cell_w = data[6];
+  s_atlas.cell_h = data[7];
+  s_atlas.count = count < MAX_ATLAS_GLYPHS ? count : MAX_ATLAS_GLYPHS;
+  const int stride = (s_atlas.cell_w * bpp + 7) / 8;
+
+  for (int i = 0; i < s_atlas.count; i++) {
+    const uint8_t *cell = &data[12 + count * 4 + i * cell_size];
+    s_atlas.codepoints[i] = data[12 + i * 4] | (data[13 + i * 4] << 8);
+    s_atlas.weights[i] = data[14 + i * 4];
+    for (int y = 0; y < s_atlas.cell_h; y++) {
+      for (int x = 0; x < s_atlas.cell_w && y * s_atlas.cell_w + x < MAX_ATLAS_CELL; x++) {
+        s_atlas.levels[i][y * s_atlas.cell_w + x] = bpp == 1
+          ? ((cell[y * stride + (x >> 3)] >> (7 - (x & 7))) & 1) * 3
+          : (cell[y * stride + (x >> 2)] >> (6 - 2 * (x & 3))) & 3;
+      }
+    }
+  }
+}
+
+/**
+ * Read a pixel of a captured frame buffer.
+ */
+static GColor prv_fb_pixel(const uint8_t *data, uint16_t bytes_per_row, int x, int y) {
+#ifdef PBL_BW
+  return (data[y * bytes_per_row + x / 8] >> (x % 8)) & 1 ? GColorWhite : GColorBlack;
+#else
+  return (GColor){ .argb = data[y * bytes_per_row + x] };
+#endif
+}
+
+/**
+ * Count the pixels of a row of a captured frame buffer that changed between
+ * x0 (inclusive) and x1 (exclusive).
+ */
+static int prv_changed_pixels(const uint8_t *before, const uint8_t *after, uint16_t bytes_per_row,
+                              int y, int x0, int x1) {
+#ifdef PBL_BW
+  const int pixels_per_byte = 8;
+#else
+  const int pixels_per_byte = 1;
+#endif
+  const int b0 = y * bytes_per_row + x0 / pixels_per_byte;
+  const int b1 = y * bytes_per_row + (x1 + pixels_per_byte - 1) / pixels_per_byte;
+  int changed = 0;
+  if (x0 >= x1 || memcmp(&before[b0], &after[b0], b1 - b0) == 0) return 0;
+  for (int x = x0; x < x1; x++) {
+    if (prv_fb_pixel(after, bytes_per_row, x, y).argb != prv_fb_pixel(before, bytes_per_row, x, y).argb) {
+      changed++;
+    }
+  }
+  return changed;
+}
+
+/**
+ * Decode one UTF-8 sequence, returning the number of bytes consumed.
+ */
+static int prv_utf8_decode(const char *s, uint32_t *cp) {
+  const uint8_t *u = (const uint8_t *)s;
+  if (u[0] < 0x80) { *cp = u[0]; return 1; }
+  if ((u[0] & 0xE0) == 0xC0) { *cp = ((u[0] & 0x1F) << 6) | (u[1] & 0x3F); return 2; }
+  *cp = ((u[0] & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+  return 3;
+}
+
+/**
+ * Find a glyph in the atlas, falling back to the "on" weight as the watch
+ * does for atlases that only store one weight.
+ *
+ * @return Index of the glyph, or -1 if it is not in the atlas
+ */
+static int prv_atlas_find(uint32_t cp, uint8_t weight) {
+  for (int i = 0; i < s_atlas.count; i++) {
+    if (s_atlas.codepoints[i] == cp && s_atlas.weights[i] == weight) return i;
+  }
+  return weight == GLYPH_WEIGHT_OFF ? prv_atlas_find(cp, GLYPH_WEIGHT_ON) : -1;
+}
+
+/**
+ * Tell whether a cell of the frame buffer shows a glyph of the atlas: every
+ * pixel the glyph fully covers has the text color and every pixel it
+ * doesn't cover is unchanged (coverage in between is blended, and not
+ * checked).
+ *
+ * @param covered Set to the number of pixels the glyph fully covers
+ */
+static bool prv_cell_shows(int glyph, const uint8_t *before, const uint8_t *after, uint16_t bytes_per_row,
+                           GPoint origin, GColor color, int *covered) {
+  const uint8_t *levels = s_atlas.levels[glyph];
+  *covered = 0;
+  for (int y = 0; y < s_atlas.cell_h; y++) {
+    const int sy = origin.y + y;
+    if (sy < 0 || sy >= PBL_DISPLAY_HEIGHT) continue;
+    for (int x = 0; x < s_atlas.cell_w; x++) {
+      const int sx = origin.x + x;
+      if (sx < 0 || sx >= PBL_DISPLAY_WIDTH) continue;
+      const int level = levels[y * s_atlas.cell_w + x];
+      const GColor pixel = prv_fb_pixel(after, bytes_per_row, sx, sy);
+#ifdef PBL_BW
+      const bool full = level >= 2; // Black and white pixels are either drawn or not
+#else
+      const bool full = level == 3;
+#endif
+      if (full) {
+        if (pixel.argb != color.argb) return false;
+        (*covered)++;
+      } else if (level == 0 && pixel.argb != prv_fb_pixel(before, bytes_per_row, sx, sy).argb) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Find the glyph of the atlas that a cell of the frame buffer shows: the
+ * expected one if it does, otherwise the matching glyph covering the most
+ * pixels.
+ *
+ * @return Index of the glyph, or -1 if none matches (e.g. a space)
+ */
+static int prv_decode_cell(int expected, const uint8_t *before, const uint8_t *after, uint16_t bytes_per_row,
+                           GPoint origin, GColor color) {
+  int best = -1, best_covered = 0, covered;
+
+  if (expected >= 0 && prv_cell_shows(expected, before, after, bytes_per_row, origin, color, &covered) && covered) {
+    return expected;
+  }
+  for (int i = 0; i < s_atlas.count; i++) {
+    if (prv_cell_shows(i, before, after, bytes_per_row, origin, color, &covered) && covered > best_covered) {
+      best = i;
+      best_covered = covered;
+    }
+  }
+  return best;
+}
+
+/**
+ * Blit text from the atlas, then read the glyphs back from the frame buffer
+ * and record them as graphics_draw_text() does, so that the lit phrase is
+ * the one actually blitted. Pixels outside the cells of the text must not
+ * change.
+ */
+static void prv_atlas_draw_text(const GlyphAtlas *atlas, GBitmap *fb, const char *text, GPoint origin,
+                                uint8_t weight, GColor color) {
+  static uint8_t before[PBL_DISPLAY_WIDTH * PBL_DISPLAY_HEIGHT];
+  const uint8_t *data = gbitmap_get_data(fb);
+  const uint16_t bytes_per_row = gbitmap_get_bytes_per_row(fb);
+  memcpy(before, data, bytes_per_row * PBL_DISPLAY_HEIGHT);
+  glyph_atlas_draw_text(atlas, fb, text, origin, weight, color);
+
+  if (!s_atlas.count) prv_atlas_load();
+  int cells = 0;
+  for (const char *c = text; *c; c++) {
+    if ((*c & 0xC0) != 0x80) cells++;
+  }
+
+  const int x0 = origin.x < 0 ? 0 : origin.x;
+  const int x1 = origin.x + cells * s_atlas.cell_w;
+  const int y0 = origin.y < 0 ? 0 : origin.y < PBL_DISPLAY_HEIGHT ? origin.y : PBL_DISPLAY_HEIGHT;
+  const int y1 = origin.y + s_atlas.cell_h < PBL_DISPLAY_HEIGHT ? origin.y + s_atlas.cell_h : PBL_DISPLAY_HEIGHT;
+  if (memcmp(before, data, y0 * bytes_per_row) != 0) {
+    for (int y = 0; y < y0; y++) {
+      s_blit_errors += prv_changed_pixels(before, data, bytes_per_row, y, 0, PBL_DISPLAY_WIDTH);
+    }
+  }
+  for (int y = y0; y < y1; y++) {
+    s_blit_errors += prv_changed_pixels(before, data, bytes_per_row, y, 0, x0);
+    s_blit_errors += prv_changed_pixels(before, data, bytes_per_row, y, x1, PBL_DISPLAY_WIDTH);
+  }
+  if (y1 < PBL_DISPLAY_HEIGHT &&
+      memcmp(&before[y1 * bytes_per_row], &data[y1 * bytes_per_row], (PBL_DISPLAY_HEIGHT - y1) * bytes_per_row) != 0) {
+    for (int y = y1; y < PBL_DISPLAY_HEIGHT; y++) {
+      s_blit_errors += prv_changed_pixels(before, data, bytes_per_row, y, 0, PBL_DISPLAY_WIDTH);
+    }
+  }
+
+  GPoint cell = origin;
+  while (*text) {
+    uint32_t cp;
+    text += prv_utf8_decode(text, &cp);
+    const int glyph = prv_decode_cell(prv_atlas_find(cp, weight), before, data, bytes_per_row, cell, color);
+    if (glyph >= 0) {
+      stub_record_glyph(cell, s_atlas.codepoints[glyph], s_atlas.weights[glyph] == GLYPH_WEIGHT_ON, color);
+    }
+    cell.x += s_atlas.cell_w;
+  }
+}
+#define glyph_atlas_draw_text prv_atlas_draw_text
+#endif
+
+#define main chronocode_main
+#include "../../src/chronocode.c"
+#undef main
+
+static int s_lang, s_tmd, s_caps, s_inv;
+
+static const char * const s_locales[] = {
+  "en_US", "da_DK", "de_DE", "es_ES", "fr_FR", "it_IT", "nl_NL", "sv_SE", "nl_BE", "pt_PT", "nb_NO"
+};
+
+static int prv_glyph_cmp(const void *a, const void *b) {
+  const StubGlyph *ga = a, *gb = b;
+  if (ga->y != gb->y) return ga->y - gb->y;
+  return ga->x - gb->x;
+}
+
+/**
+ * Write the emphasized glyphs of the current frame as a phrase, e.g. "IT IS TEN OCLOCK".
+ */
+static void prv_print_lit(FILE *out) {
+  size_t n;
+  const StubGlyph *drawn = stub_glyphs(&n);
+  StubGlyph g[n ? n : 1];
+  size_t lit = 0;
+  for (size_t i = 0; i < n; i++) {
+    const bool contrast = gcolor_equal(drawn[i].color, GColorWhite) || gcolor_equal(drawn[i].color, GColorBlack);
+    if (drawn[i].bold && contrast) g[lit++] = drawn[i];
+  }
+  // Glyphs are collected in drawing order; emit them in reading order
+  qsort(g, lit, sizeof(*g), prv_glyph_cmp);
+  for (size_t i = 0; i < lit; i++) {
+    if (i > 0 && g[i].x == g[i - 1].x && g[i].y == g[i - 1].y) continue;
+    if (i > 0 && (g[i].y != g[i - 1].y || g[i].x != g[i - 1].x + FONT_W)) fputc(' ', out);
+    uint32_t cp = g[i].codepoint;
+    if (cp < 0x80) fputc((int)cp, out);
+    else if (cp < 0x800) { fputc(0xC0 | (cp >> 6), out); fputc(0x80 | (cp & 0x3F), out); }
+    else { fputc(0xE0 | (cp >> 12), out); fputc(0x80 | ((cp >> 6) & 0x3F), out); fputc(0x80 | (cp & 0x3F), out); }
+  }
+}
+
+/**
+ * Send the current settings, as the phone does when any of them is changed.
+ */
+static void prv_send_settings(void) {
+  const uint32_t keys[] = { MESSAGE_KEY_language, MESSAGE_KEY_twoMinDots, MESSAGE_KEY_allCaps, MESSAGE_KEY_inverted };
+  const int32_t values[] = { s_lang, s_tmd, s_caps, s_inv };
+  stub_send_message(keys, values, 4);
+}
+
+/**
+ * Start the app, apply settings as the phone would and run it through a day,
+ * calling `minute` after each minute's frame has been rendered.
+ */
+static void prv_run_day(void (*minute)(int m)) {
+  prv_send_settings();
+  stub_render();
+
+  const time_t day = 1767225600; // 2026-01-01 00:00:00 UTC
+  for (int m = 0; m < 24 * 60; m++) {
+    stub_tick(day + m * 60);
+    stub_render();
+    minute(m);
+  }
+}
+
+static void prv_dump_minute(int m) {
+  printf("%02d:%02d %08x ", m / 60, m % 60, stub_framebuffer_hash());
+  prv_print_lit(stdout);
+  putchar('\n');
+}
+
+static void prv_dump_loop(void) {
+  prv_run_day(prv_dump_minute);
+}
+
+static char s_run_phrase[256];
+static int s_run_start;
+static uint32_t s_run_hash;
+
+static void prv_print_run(int end) {
+  printf("%02d:%02d-%02d:%02d %08x %s\n", s_run_start / 60, s_run_start % 60, end / 60, end % 60,
+         s_run_hash, s_run_phrase);
+}
+
+static void prv_golden_minute(int m) {
+  char phrase[256] = "";
+  FILE *out = fmemopen(phrase, sizeof(phrase), "w");
+  prv_print_lit(out);
+  fclose(out);
+
+  if (m > 0 && strcmp(phrase, s_run_phrase) != 0) {
+    prv_print_run(m - 1);
+  }
+  if (m == 0 || strcmp(phrase, s_run_phrase) != 0) {
+    strcpy(s_run_phrase, phrase);
+    s_run_start = m;
+    s_run_hash = 2166136261u;
+  }
+  // FNV-1a over the frame hashes of the run
+  const uint32_t frame = stub_framebuffer_hash();
+  for (int i = 0; i < 4; i++) {
+    s_run_hash = (s_run_hash ^ ((frame >> (i * 8)) & 0xFF)) * 16777619u;
+  }
+  if (m == 24 * 60 - 1) {
+    prv_print_run(m);
+  }
+}
+
+static void prv_golden_loop(void) {
+  prv_run_day(prv_golden_minute);
+}
+
+static void prv_golden_language(void) {
+  for (s_tmd = 0; s_tmd < 2; s_tmd++) {
+    printf("# %s twoMinDots=%d\n", s_locales[s_lang], s_tmd);
+    stub_persist_clear();
+    stub_set_event_loop(prv_golden_loop);
+    chronocode_main();
+  }
+}
+
+static int prv_golden(int argc, char **argv) {
+  if (argc == 0) {
+    for (s_lang = 0; s_lang <= LANG_NB_NO; s_lang++) {
+      prv_golden_language();
+    }
+    return 0;
+  }
+  stub_set_resource_file(RESOURCE_ID_CHRONOCODE_PACKS, argv[0]);
+  for (int i = 1; i < argc; i++) {
+    s_lang = atoi(argv[i]);
+    if (s_lang < 0 || s_lang > LANG_NB_NO) {
+      fprintf(stderr, "unknown language %s\n", argv[i]);
+      return 2;
+    }
+    prv_golden_language();
+  }
+  return 0;
+}
+
+static void prv_frames_loop(void) {
+  prv_send_settings();
+  for (unsigned i = 1; i < word_count; i++) {
+    if (!mywords[i].text_on) continue;
+    const GRect frame = prv_word_frame(i);
+    printf("%d %u %d %d %d %d\n", s_lang, i, frame.origin.x, frame.origin.y, frame.size.w, frame.size.h);
+  }
+}
+
+static int prv_frames(void) {
+  for (s_lang = 0; s_lang <= LANG_NB_NO; s_lang++) {
+    stub_persist_clear();
+    stub_set_event_loop(prv_frames_loop);
+    chronocode_main();
+  }
+  return 0;
+}
+
+static int s_bench_days;
+static uint64_t s_tick_ns, s_render_ns;
+
+static uint64_t prv_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void prv_bench_loop(void) {
+  prv_send_settings();
+  stub_render();
+  stub_stats_reset();
+  s_tick_ns = s_render_ns = 0;
+
+  const time_t start = 1767225600; // 2026-01-01 00:00:00 UTC
+  for (int m = 0; m < s_bench_days * 24 * 60; m++) {
+    const uint64_t t0 = prv_now_ns();
+    stub_tick(start + m * 60);
+    const uint64_t t1 = prv_now_ns();
+    stub_render();
+    const uint64_t t2 = prv_now_ns();
+    s_tick_ns += t1 - t0;
+    s_render_ns += t2 - t1;
+  }
+}
+
+static int prv_bench(int days) {
+  s_bench_days = days > 0 ? days : 1;
+  const double ticks = s_bench_days * 24.0 * 60.0;
+  printf("%-6s %-3s %-4s %-3s %9s %11s %9s %9s %9s %9s %11s %8s\n", "lang", "tmd", "caps", "inv",
+         "ns/tick", "ns/redraw", "set_text", "set_font", "set_color", "dirty", "pixels", "reads");
+  for (s_lang = 0; s_lang <= LANG_NB_NO; s_lang++) {
+    for (int combo = 0; combo < 8; combo++) {
+      s_tmd = combo & 1;
+      s_caps = (combo >> 1) & 1;
+      s_inv = (combo >> 2) & 1;
+      stub_persist_clear();
+      stub_set_event_loop(prv_bench_loop);
+      chronocode_main();
+      // Counters are per tick; resource reads include the lit-word table lookups
+      printf("%-6s %-3d %-4d %-3d %9.0f %11.0f %9.2f %9.2f %9.2f %9.2f %11.1f %8.2f\n",
+             s_locales[s_lang], s_tmd, s_caps, s_inv, s_tick_ns / ticks, s_render_ns / ticks,
+             stub_stats.text_layer_set_text / ticks, stub_stats.text_layer_set_font / ticks,
+             stub_stats.text_layer_set_text_color / ticks, stub_stats.dirty_layers / ticks,
+             stub_stats.pixels_redrawn / ticks, stub_stats.resource_reads / ticks);
+    }
+  }
+  return 0;
+}
+
+static int s_failures;
+static unsigned s_persist_writes;
+
+static void prv_check_minute(int m) {
+  char phrase[256] = "";
+  FILE *out = fmemopen(phrase, sizeof(phrase), "w");
+  prv_print_lit(out);
+  fclose(out);
+  if (phrase[0] == '\0') {
+    fprintf(stderr, "FAIL lang %d tmd %d caps %d inv %d %02d:%02d: no words lit\n",
+            s_lang, s_tmd, s_caps, s_inv, m / 60, m % 60);
+    s_failures++;
+  }
+}
+
+static void prv_check_loop(void) {
+  prv_run_day(prv_check_minute);
+
+#ifdef GLYPH_ATLAS_RENDERER
+  // The words must have been blitted from the atlas, not drawn with the fonts
+  if (!glyph_atlas || stub_stats.glyphs_drawn != 0) {
+    fprintf(stderr, "FAIL lang %d tmd %d caps %d inv %d: %s\n", s_lang, s_tmd, s_caps, s_inv,
+            glyph_atlas ? "words drawn with the fonts" : "glyph atlas not loaded");
+    s_failures++;
+  }
+  if (s_blit_errors) {
+    fprintf(stderr, "FAIL lang %d tmd %d caps %d inv %d: %d pixels blitted outside the words' cells\n",
+            s_lang, s_tmd, s_caps, s_inv, s_blit_errors);
+    s_failures++;
+    s_blit_errors = 0;
+  }
+#endif
+
+  // Running out of memory while switching language must leave a language
+  // shown (the allocations are those of the pack load and the layers array)
+  for (int n = 0; n < 4; n++) {
+    const uint32_t key = MESSAGE_KEY_language;
+    const int32_t language = (s_lang + 1 + n) % (LANG_NB_NO + 1);
+    stub_fail_allocation(n);
+    stub_send_message(&key, &language, 1);
+    stub_fail_allocation(-1);
+    stub_render();
+    prv_check_minute(24 * 60 - 1);
+  }
+  prv_send_settings();
+  stub_render();
+
+  // Sending the same settings again must not write them again
+  s_persist_writes = stub_stats.persist_writes;
+  prv_send_settings();
+  stub_render();
+
+#ifdef PERF_INSTRUMENTATION
+  // A tap sends all the measurement slots in one message
+  const unsigned sent = stub_stats.app_messages_sent;
+  const unsigned long bytes = stub_stats.app_message_bytes;
+  stub_tap();
+  if (stub_stats.app_messages_sent != sent + 1 || stub_stats.app_message_bytes != bytes + PERF_DATA_SIZE) {
+    fprintf(stderr, "FAIL lang %d tmd %d caps %d inv %d: tap sent %u messages of %lu bytes\n", s_lang, s_tmd,
+            s_caps, s_inv, stub_stats.app_messages_sent - sent, stub_stats.app_message_bytes - bytes);
+    s_failures++;
+  }
+#endif
+}
+
+static int prv_check(void) {
+  for (s_lang = 0; s_lang <= LANG_NB_NO; s_lang++) {
+    for (int combo = 0; combo < 8; combo++) {
+      s_tmd = combo & 1;
+      s_caps = (combo >> 1) & 1;
+      s_inv = (combo >> 2) & 1;
+      stub_persist_clear();
+      stub_set_event_loop(prv_check_loop);
+      chronocode_main();
+      if (stub_live_layers() != 0 || heap_bytes_used() != 0) {
+        fprintf(stderr, "FAIL lang %d tmd %d caps %d inv %d: %u layers and %u heap bytes left after exit\n",
+                s_lang, s_tmd, s_caps, s_inv, stub_live_layers(), (unsigned)heap_bytes_used());
+        s_failures++;
+      }
+      if (stub_stats.persist_writes != s_persist_writes) {
+        fprintf(stderr, "FAIL lang %d tmd %d caps %d inv %d: unchanged settings written %u times\n",
+                s_lang, s_tmd, s_caps, s_inv, stub_stats.persist_writes - s_persist_writes);
+        s_failures++;
+      }
+    }
+  }
+  printf("%s: %d failures\n", s_failures ? "FAIL" : "OK", s_failures);
+  return s_failures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+  stub_set_time(1767225600);
+  if (argc == 2 && strcmp(argv[1], "check") == 0) {
+    return prv_check();
+  }
+  if ((argc == 2 || argc >= 4) && strcmp(argv[1], "golden") == 0) {
+    return prv_golden(argc - 2, &argv[2]);
+  }
+  if (argc == 2 && strcmp(argv[1], "frames") == 0) {
+    return prv_frames();
+  }
+  if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+    return prv_bench(argc > 2 ? atoi(argv[2]) : 1);
+  }
+  if (argc < 3 || strcmp(argv[1], "dump") != 0) {
+    fprintf(stderr, "usage: %s dump <language id> [tmd] [caps] [inverted]\n"
+                    "       %s check\n"
+                    "       %s golden [<packs file> <language id>...]\n"
+                    "       %s frames\n"
+                    "       %s bench [days]\n", argv[0], argv[0], argv[0], argv[0], argv[0]);
+    return 2;
+  }
+  s_lang = atoi(argv[2]);
+  s_tmd = argc > 3 ? atoi(argv[3]) : 0;
+  s_caps = argc > 4 ? atoi(argv[4]) : 0;
+  s_inv = argc > 5 ? atoi(argv[5]) : 0;
+  stub_set_event_loop(prv_dump_loop);
+  chronocode_main();
+  return 0;
+}
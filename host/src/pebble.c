@@ -0,0 +1,1100 @@
+/**
+ * Host-side implementation of the Pebble API subset declared in pebble.h.
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ */
+#include <stdarg.h>
+#include <pebble.h>
+#include "stub.h"
+
+// The stubs themselves use the real allocator
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+#undef time
+#undef localtime
+
+#define SCREEN_W PBL_DISPLAY_WIDTH
+#define SCREEN_H PBL_DISPLAY_HEIGHT
+#define HEAP_SIZE (24 * 1024)
+#define MAX_GLYPHS 1024
+#define MAX_PERSIST 16
+#define DEFAULT_FONT_SIZE 20
+
+StubStats stub_stats;
+
+// Internal types
+
+typedef enum {
+  LAYER_KIND_PLAIN,
+  LAYER_KIND_TEXT,
+  LAYER_KIND_ROOT
+} LayerKind;
+
+struct Layer {
+  GRect frame;
+  Layer *parent;
+  Layer *first_child;
+  Layer *next_sibling;
+  LayerUpdateProc update_proc;
+  LayerKind kind;
+  bool hidden;
+  bool dirty;
+  void *data;
+};
+
+struct TextLayer {
+  Layer layer;
+  const char *text;
+  GFont font;
+  GColor text_color;
+  GColor background_color;
+  GTextAlignment alignment;
+};
+
+struct Window {
+  Layer root;
+  GColor background_color;
+  WindowHandlers handlers;
+  bool loaded;
+};
+
+struct StubFont {
+  uint32_t resource_id;
+  bool bold;
+  bool system;
+  uint8_t size;     /**< Pixel size, from the resource name (e.g. FONT_X_20) */
+  uint8_t advance;  /**< Glyph advance: 0.6 em, as SourceCodePro */
+  uint8_t line_height;
+};
+
+struct StubResource {
+  const char *name;
+  const char *type;
+  const char *file;
+};
+
+struct GContext {
+  GColor stroke_color;
+  GColor fill_color;
+  GColor text_color;
+  GPoint offset;
+  GRect clip;
+};
+
+static const struct StubResource s_resources[STUB_RESOURCE_COUNT] = { STUB_RESOURCE_TABLE };
+static struct StubResourceData {
+  bool loaded;
+  size_t size;
+  uint8_t *data;
+} s_resource_data[STUB_RESOURCE_COUNT];
+static const char *s_resource_dir = "../resources";
+static const char *s_resource_files[STUB_RESOURCE_COUNT];
+static bool s_log_output;
+static time_t s_now;
+static struct tm s_tm;
+static TickHandler s_tick_handler;
+static AccelTapHandler s_tap_handler;
+static void (*s_event_loop)(void);
+static AppMessageInboxReceived s_inbox_handler;
+static uint32_t s_outbox_size;
+static uint32_t s_outbox_free;
+static Window *s_top_window;
+static GColor s_framebuffer[SCREEN_W * SCREEN_H];
+static uint8_t s_dirty_mask[SCREEN_W * SCREEN_H];
+static StubGlyph s_glyphs[MAX_GLYPHS];
+static size_t s_glyph_count;
+static size_t s_heap_used;
+static int s_failing_allocation = -1;
+static unsigned s_live_layers;
+
+static struct {
+  bool used;
+  uint32_t key;
+  size_t size;
+  uint8_t data[256];
+} s_persist[MAX_PERSIST];
+
+// Logging
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...) {
+  stub_stats.app_logs++;
+  if (!s_log_output) return;
+  va_list args;
+  va_start(args, fmt);
+  fprintf(stderr, "[%u] %s:%d> ", log_level, src_filename, src_line_number);
+  vfprintf(stderr, fmt, args);
+  fputc('\n', stderr);
+  va_end(args);
+}
+
+void stub_set_log_output(bool enabled) {
+  s_log_output = enabled;
+}
+
+// Memory (each block is prefixed with its size so usage can be tracked)
+
+typedef union {
+  size_t size;
+  max_align_t align;
+} HeapHeader;
+
+void stub_fail_allocation(int n) {
+  s_failing_allocation = n;
+}
+
+void *stub_malloc(size_t size) {
+  if (s_failing_allocation >= 0 && s_failing_allocation-- == 0) return NULL;
+  if (s_heap_used + size > HEAP_SIZE) return NULL;
+  HeapHeader *h = malloc(sizeof(HeapHeader) + size);
+  if (!h) return NULL;
+  h->size = size;
+  s_heap_used += size;
+  return h + 1;
+}
+
+void *stub_calloc(size_t count, size_t size) {
+  void *p = stub_malloc(count * size);
+  if (p) memset(p, 0, count * size);
+  return p;
+}
+
+void stub_free(void *ptr) {
+  if (!ptr) return;
+  HeapHeader *h = (HeapHeader *)ptr - 1;
+  s_heap_used -= h->size;
+  free(h);
+}
+
+void *stub_realloc(void *ptr, size_t size) {
+  if (!ptr) return stub_malloc(size);
+  HeapHeader *h = (HeapHeader *)ptr - 1;
+  void *p = stub_malloc(size);
+  if (!p) return NULL;
+  memcpy(p, ptr, h->size < size ? h->size : size);
+  stub_free(ptr);
+  return p;
+}
+
+size_t heap_bytes_used(void) {
+  return s_heap_used;
+}
+
+size_t heap_bytes_free(void) {
+  return HEAP_SIZE - s_heap_used;
+}
+
+// Time
+
+time_t stub_time(time_t *tloc) {
+  if (tloc) *tloc = s_now;
+  return s_now;
+}
+
+struct tm *stub_localtime(const time_t *timep) {
+  gmtime_r(timep, &s_tm);
+  return &s_tm;
+}
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint16_t ms = (uint16_t)(ts.tv_nsec / 1000000);
+  if (tloc) *tloc = ts.tv_sec;
+  if (out_ms) *out_ms = ms;
+  return ms;
+}
+
+void stub_set_time(time_t now) {
+  s_now = now;
+}
+
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) {
+  s_tick_handler = handler;
+}
+
+void tick_timer_service_unsubscribe(void) {
+  s_tick_handler = NULL;
+}
+
+// Accelerometer
+
+void accel_tap_service_subscribe(AccelTapHandler handler) {
+  s_tap_handler = handler;
+}
+
+void accel_tap_service_unsubscribe(void) {
+  s_tap_handler = NULL;
+}
+
+void stub_tap(void) {
+  if (s_tap_handler) s_tap_handler(ACCEL_AXIS_Z, 1);
+}
+
+void stub_tick(time_t now) {
+  s_now = now;
+  if (!s_tick_handler) return;
+  struct tm t;
+  gmtime_r(&now, &t);
+  s_tick_handler(&t, MINUTE_UNIT);
+}
+
+// Geometry and colors
+
+bool grect_equal(const GRect * const rect_a, const GRect * const rect_b) {
+  return memcmp(rect_a, rect_b, sizeof(GRect)) == 0;
+}
+
+GRect grect_inset(GRect rect, int16_t inset) {
+  return GRect(rect.origin.x + inset, rect.origin.y + inset, rect.size.w - 2 * inset, rect.size.h - 2 * inset);
+}
+
+bool gcolor_equal(GColor8 x, GColor8 y) {
+  return x.argb == y.argb;
+}
+
+// Resources
+
+void stub_set_resource_dir(const char *dir) {
+  s_resource_dir = dir;
+  for (size_t i = 0; i < STUB_RESOURCE_COUNT; i++) {
+    free(s_resource_data[i].data);
+    s_resource_data[i] = (struct StubResourceData){ 0 };
+  }
+}
+
+void stub_set_resource_file(uint32_t resource_id, const char *path) {
+  if (resource_id == 0 || resource_id >= STUB_RESOURCE_COUNT) return;
+  s_resource_files[resource_id] = path;
+  free(s_resource_data[resource_id].data);
+  s_resource_data[resource_id] = (struct StubResourceData){ 0 };
+}
+
+ResHandle resource_get_handle(uint32_t resource_id) {
+  if (resource_id == 0 || resource_id >= STUB_RESOURCE_COUNT) return NULL;
+  return &s_resources[resource_id];
+}
+
+#if defined(PBL_PLATFORM_APLITE)
+#define STUB_PLATFORM_TAG "aplite"
+#elif defined(PBL_PLATFORM_BASALT)
+#define STUB_PLATFORM_TAG "basalt"
+#elif defined(PBL_PLATFORM_CHALK)
+#define STUB_PLATFORM_TAG "chalk"
+#elif defined(PBL_PLATFORM_DIORITE)
+#define STUB_PLATFORM_TAG "diorite"
+#elif defined(PBL_PLATFORM_EMERY)
+#define STUB_PLATFORM_TAG "emery"
+#elif defined(PBL_PLATFORM_FLINT)
+#define STUB_PLATFORM_TAG "flint"
+#else
+#define STUB_PLATFORM_TAG "gabbro"
+#endif
+
+/**
+ * Open a resource file, preferring tagged variants ("name~tag.ext") the way
+ * the SDK's resource build picks them for a platform.
+ */
+static FILE *prv_resource_open(ResHandle h) {
+  static const char * const tags[] = {
+    STUB_PLATFORM_TAG,
+    PBL_IF_COLOR_ELSE("color", "bw"),
+    PBL_IF_ROUND_ELSE("round", "rect"),
+  };
+  char path[512];
+  if (!h) return NULL;
+  if (s_resource_files[h - s_resources]) {
+    FILE *fp = fopen(s_resource_files[h - s_resources], "rb");
+    if (!fp) fprintf(stderr, "stub: cannot open resource %s\n", s_resource_files[h - s_resources]);
+    return fp;
+  }
+
+  const char *dot = strrchr(h->file, '.');
+  const int stem = dot ? (int)(dot - h->file) : (int)strlen(h->file);
+  for (size_t i = 0; i < sizeof(tags) / sizeof(*tags); i++) {
+    snprintf(path, sizeof(path), "%s/%.*s~%s%s", s_resource_dir, stem, h->file, tags[i], dot ? dot : "");
+    FILE *fp = fopen(path, "rb");
+    if (fp) return fp;
+  }
+
+  snprintf(path, sizeof(path), "%s/%s", s_resource_dir, h->file);
+  FILE *fp = fopen(path, "rb");
+  if (!fp) fprintf(stderr, "stub: cannot open resource %s\n", path);
+  return fp;
+}
+
+/**
+ * Get the contents of a resource, reading its file only on first use so that
+ * resource reads cost about what they do on the watch rather than a file open.
+ */
+static const struct StubResourceData *prv_resource_data(ResHandle h) {
+  if (!h) return NULL;
+  struct StubResourceData *d = &s_resource_data[h - s_resources];
+  if (!d->loaded) {
+    FILE *fp = prv_resource_open(h);
+    if (!fp) return NULL;
+    fseek(fp, 0, SEEK_END);
+    const long size = ftell(fp);
+    d->size = size < 0 ? 0 : (size_t)size;
+    d->data = malloc(d->size ? d->size : 1);
+    fseek(fp, 0, SEEK_SET);
+    d->size = fread(d->data, 1, d->size, fp);
+    fclose(fp);
+    d->loaded = true;
+  }
+  return d;
+}
+
+size_t resource_size(ResHandle h) {
+  const struct StubResourceData *d = prv_resource_data(h);
+  return d ? d->size : 0;
+}
+
+size_t resource_load_byte_range(ResHandle h, uint32_t start_offset, uint8_t *buffer, size_t num_bytes) {
+  stub_stats.resource_reads++;
+  const struct StubResourceData *d = prv_resource_data(h);
+  if (!d || start_offset >= d->size) return 0;
+  const size_t n = d->size - start_offset < num_bytes ? d->size - start_offset : num_bytes;
+  memcpy(buffer, &d->data[start_offset], n);
+  stub_stats.resource_bytes += n;
+  return n;
+}
+
+size_t resource_load(ResHandle h, uint8_t *buffer, size_t max_length) {
+  return resource_load_byte_range(h, 0, buffer, max_length);
+}
+
+// Fonts
+
+GFont fonts_load_custom_font(ResHandle handle) {
+  if (!handle) return NULL;
+  struct StubFont *font = stub_malloc(sizeof(struct StubFont));
+  font->resource_id = (uint32_t)(handle - s_resources);
+  font->bold = strstr(handle->name, "BLACK") != NULL || strstr(handle->name, "BOLD") != NULL;
+  font->system = false;
+  const char *size = strrchr(handle->name, '_');
+  font->size = size && atoi(size + 1) > 0 ? atoi(size + 1) : DEFAULT_FONT_SIZE;
+  font->advance = (font->size * 3 + 2) / 5;
+  font->line_height = font->size * 6 / 5;
+  stub_stats.fonts_loaded++;
+  return font;
+}
+
+void fonts_unload_custom_font(GFont font) {
+  if (font && !font->system) stub_free(font);
+}
+
+GFont fonts_get_system_font(const char *font_key) {
+  static struct StubFont system_font = {
+    0, false, true, DEFAULT_FONT_SIZE, (DEFAULT_FONT_SIZE * 3 + 2) / 5, DEFAULT_FONT_SIZE * 6 / 5
+  };
+  system_font.bold = strstr(font_key, "BOLD") != NULL;
+  return &system_font;
+}
+
+// Framebuffer drawing
+
+static void prv_plot(GContext *ctx, int x, int y, GColor color) {
+  if (color.argb == GColorClear.argb) return;
+  x += ctx->offset.x;
+  y += ctx->offset.y;
+  if (x < ctx->clip.origin.x || y < ctx->clip.origin.y ||
+      x >= ctx->clip.origin.x + ctx->clip.size.w || y >= ctx->clip.origin.y + ctx->clip.size.h) {
+    return;
+  }
+  if (x < 0 || y < 0 || x >= SCREEN_W || y >= SCREEN_H) return;
+#ifdef PBL_BW
+  // Only black and white pixels exist on these displays
+  color = (color.argb == GColorWhite.argb || color.argb == GColorLightGray.argb) ? GColorWhite : GColorBlack;
+#endif
+  s_framebuffer[y * SCREEN_W + x] = color;
+}
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+void graphics_context_set_text_color(GContext *ctx, GColor color) {
+  ctx->text_color = color;
+}
+
+void graphics_draw_pixel(GContext *ctx, GPoint point) {
+  prv_plot(ctx, point.x, point.y, ctx->stroke_color);
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+  if (gcolor_equal(ctx->fill_color, GColorClear)) return;
+  const int x1 = rect.origin.x + rect.size.w - 1;
+  const int y1 = rect.origin.y + rect.size.h - 1;
+  for (int y = rect.origin.y; y <= y1; y++) {
+    for (int x = rect.origin.x; x <= x1; x++) {
+      if (corner_radius > 0) {
+        // Knock out the corner pixels of rounded corners
+        const bool left = x == rect.origin.x, right = x == x1, top = y == rect.origin.y, bottom = y == y1;
+        if ((top && left && (corner_mask & GCornerTopLeft)) ||
+            (top && right && (corner_mask & GCornerTopRight)) ||
+            (bottom && left && (corner_mask & GCornerBottomLeft)) ||
+            (bottom && right && (corner_mask & GCornerBottomRight))) {
+          continue;
+        }
+      }
+      prv_plot(ctx, x, y, ctx->fill_color);
+    }
+  }
+}
+
+void graphics_draw_rect(GContext *ctx, GRect rect) {
+  const int x1 = rect.origin.x + rect.size.w - 1;
+  const int y1 = rect.origin.y + rect.size.h - 1;
+  for (int x = rect.origin.x; x <= x1; x++) {
+    prv_plot(ctx, x, rect.origin.y, ctx->stroke_color);
+    prv_plot(ctx, x, y1, ctx->stroke_color);
+  }
+  for (int y = rect.origin.y; y <= y1; y++) {
+    prv_plot(ctx, rect.origin.x, y, ctx->stroke_color);
+    prv_plot(ctx, x1, y, ctx->stroke_color);
+  }
+}
+
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius) {
+  const int r2 = radius * radius + radius;
+  for (int dy = -radius; dy <= radius; dy++) {
+    for (int dx = -radius; dx <= radius; dx++) {
+      if (dx * dx + dy * dy <= r2) prv_plot(ctx, p.x + dx, p.y + dy, ctx->fill_color);
+    }
+  }
+}
+
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius) {
+  const int outer = radius * radius + radius;
+  const int inner = radius * radius - radius;
+  for (int dy = -radius; dy <= radius; dy++) {
+    for (int dx = -radius; dx <= radius; dx++) {
+      const int d = dx * dx + dy * dy;
+      if (d <= outer && d >= inner) prv_plot(ctx, p.x + dx, p.y + dy, ctx->stroke_color);
+    }
+  }
+}
+
+// Frame buffer access
+
+struct GBitmap {
+  GBitmapFormat format;
+  uint16_t bytes_per_row;
+  uint8_t data[SCREEN_W * SCREEN_H];
+};
+
+static GBitmap s_captured;
+static bool s_fb_captured;
+
+/**
+ * Hand out the frame buffer in the platform's native format: 1 bit per pixel
+ * (least significant bit first, 1 = white) on black and white platforms, one
+ * GColor8 per pixel on color platforms. Changes are copied back on release.
+ */
+GBitmap *graphics_capture_frame_buffer(GContext *ctx) {
+  if (s_fb_captured) return NULL;
+  s_fb_captured = true;
+#ifdef PBL_BW
+  s_captured.format = GBitmapFormat1Bit;
+  s_captured.bytes_per_row = (SCREEN_W + 31) / 32 * 4;
+  memset(s_captured.data, 0, sizeof(s_captured.data));
+  for (int y = 0; y < SCREEN_H; y++) {
+    for (int x = 0; x < SCREEN_W; x++) {
+      if (gcolor_equal(s_framebuffer[y * SCREEN_W + x], GColorWhite)) {
+        s_captured.data[y * s_captured.bytes_per_row + x / 8] |= 1 << (x % 8);
+      }
+    }
+  }
+#else
+  s_captured.format = GBitmapFormat8Bit;
+  s_captured.bytes_per_row = SCREEN_W;
+  for (size_t i = 0; i < SCREEN_W * SCREEN_H; i++) {
+    s_captured.data[i] = s_framebuffer[i].argb;
+  }
+#endif
+  return &s_captured;
+}
+
+bool graphics_release_frame_buffer(GContext *ctx, GBitmap *buffer) {
+  if (!s_fb_captured || buffer != &s_captured) return false;
+  s_fb_captured = false;
+  for (int y = 0; y < SCREEN_H; y++) {
+    for (int x = 0; x < SCREEN_W; x++) {
+#ifdef PBL_BW
+      const bool white = (s_captured.data[y * s_captured.bytes_per_row + x / 8] >> (x % 8)) & 1;
+      s_framebuffer[y * SCREEN_W + x] = white ? GColorWhite : GColorBlack;
+#else
+      s_framebuffer[y * SCREEN_W + x].argb = s_captured.data[y * SCREEN_W + x];
+#endif
+    }
+  }
+  return true;
+}
+
+uint8_t *gbitmap_get_data(const GBitmap *bitmap) {
+  return (uint8_t *)bitmap->data;
+}
+
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap) {
+  return bitmap->bytes_per_row;
+}
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) {
+  return GRect(0, 0, SCREEN_W, SCREEN_H);
+}
+
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap) {
+  return bitmap->format;
+}
+
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y) {
+  return (GBitmapDataRowInfo){
+    .data = (uint8_t *)&bitmap->data[y * bitmap->bytes_per_row],
+    .min_x = 0,
+    .max_x = SCREEN_W - 1,
+  };
+}
+
+/**
+ * Decode one UTF-8 sequence, returning the number of bytes consumed.
+ */
+static int prv_utf8_decode(const char *s, uint32_t *cp) {
+  const uint8_t *u = (const uint8_t *)s;
+  if (u[0] < 0x80) { *cp = u[0]; return 1; }
+  if ((u[0] & 0xE0) == 0xC0 && u[1]) { *cp = ((u[0] & 0x1F) << 6) | (u[1] & 0x3F); return 2; }
+  if ((u[0] & 0xF0) == 0xE0 && u[1] && u[2]) {
+    *cp = ((u[0] & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+    return 3;
+  }
+  *cp = 0xFFFD;
+  return 1;
+}
+
+/**
+ * Add a glyph to those drawn by the current frame.
+ */
+static void prv_record_glyph(int x, int y, uint32_t cp, bool bold, GColor color) {
+  if (cp == ' ' || s_glyph_count == MAX_GLYPHS) return;
+  s_glyphs[s_glyph_count++] = (StubGlyph) {
+    .x = x,
+    .y = y,
+    .codepoint = cp,
+    .bold = bold,
+    .color = color
+  };
+}
+
+/**
+ * Rasterize a stand-in glyph: a deterministic pattern derived from the code
+ * point, denser for heavy fonts, inside a box one pixel narrower than the
+ * advance on each side (10x14 in a 12px wide cell at 20px).
+ */
+static void prv_draw_glyph(GContext *ctx, int x, int y, uint32_t cp, GFont font) {
+  if (cp == ' ') return;
+  const bool bold = font->bold;
+  const int glyph_w = font->advance - 2;
+  const int glyph_h = font->size * 7 / 10;
+  const int top = font->size * 3 / 10;
+  for (int gy = 0; gy < glyph_h; gy++) {
+    for (int gx = 0; gx < glyph_w; gx++) {
+      uint32_t h = (cp * 2654435761u) ^ (uint32_t)(gy * 31 + gx) * 40503u;
+      h ^= h >> 13;
+      h *= 0x5bd1e995u;
+      h ^= h >> 15;
+      const bool edge = gx == 0 || gx == glyph_w - 1 || gy == 0 || gy == glyph_h - 1;
+      if (bold ? ((h & 3) != 0 || edge) : ((h & 7) == 0 || (edge && (h & 1)))) {
+        prv_plot(ctx, x + 1 + gx, y + top + gy, ctx->text_color);
+      }
+    }
+  }
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont const font, const GRect box,
+                        const GTextOverflowMode overflow_mode, const GTextAlignment alignment,
+                        void *text_attributes) {
+  if (!text || !font) return;
+  int x = box.origin.x;
+  int y = box.origin.y;
+  while (*text) {
+    uint32_t cp;
+    text += prv_utf8_decode(text, &cp);
+    if (cp == '\n' || x + font->advance > box.origin.x + box.size.w) {
+      // Wrap onto the next line; lines that do not fit vertically are dropped
+      x = box.origin.x;
+      y += font->line_height;
+      if (cp == '\n') continue;
+    }
+    if (y + font->line_height > box.origin.y + box.size.h) break;
+    prv_draw_glyph(ctx, x, y, cp, font);
+    prv_record_glyph(x + ctx->offset.x, y + ctx->offset.y, cp, font->bold, ctx->text_color);
+    stub_stats.glyphs_drawn++;
+    x += font->advance;
+  }
+}
+
+void stub_record_glyph(GPoint origin, uint32_t codepoint, bool bold, GColor color) {
+  prv_record_glyph(origin.x, origin.y, codepoint, bold, color);
+}
+
+// Layers
+
+static void prv_layer_init(Layer *layer, GRect frame, LayerKind kind) {
+  memset(layer, 0, sizeof(*layer));
+  layer->frame = frame;
+  layer->kind = kind;
+  layer->dirty = true;
+  s_live_layers++;
+}
+
+Layer *layer_create(GRect frame) {
+  return layer_create_with_data(frame, 0);
+}
+
+Layer *layer_create_with_data(GRect frame, size_t data_size) {
+  Layer *layer = stub_malloc(sizeof(Layer) + data_size);
+  if (!layer) return NULL;
+  prv_layer_init(layer, frame, LAYER_KIND_PLAIN);
+  if (data_size) {
+    layer->data = layer + 1;
+    memset(layer->data, 0, data_size);
+  }
+  stub_stats.layers_created++;
+  return layer;
+}
+
+void layer_remove_from_parent(Layer *child) {
+  Layer *parent = child->parent;
+  if (!parent) return;
+  Layer **link = &parent->first_child;
+  while (*link && *link != child) link = &(*link)->next_sibling;
+  if (*link) *link = child->next_sibling;
+  child->parent = NULL;
+  child->next_sibling = NULL;
+  parent->dirty = true;
+}
+
+static void prv_layer_deinit(Layer *layer) {
+  layer_remove_from_parent(layer);
+  // Orphan any children, as the firmware does
+  for (Layer *c = layer->first_child; c; ) {
+    Layer *next = c->next_sibling;
+    c->parent = NULL;
+    c->next_sibling = NULL;
+    c = next;
+  }
+  s_live_layers--;
+}
+
+void layer_destroy(Layer *layer) {
+  if (!layer) return;
+  prv_layer_deinit(layer);
+  stub_stats.layers_destroyed++;
+  stub_free(layer);
+}
+
+void *layer_get_data(const Layer *layer) {
+  return layer->data;
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+void layer_mark_dirty(Layer *layer) {
+  stub_stats.layer_mark_dirty++;
+  layer->dirty = true;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+  if (child->parent) layer_remove_from_parent(child);
+  Layer **link = &parent->first_child;
+  while (*link) link = &(*link)->next_sibling;
+  *link = child;
+  child->parent = parent;
+  child->dirty = true;
+}
+
+void layer_insert_below_sibling(Layer *layer_to_insert, Layer *below_sibling_layer) {
+  Layer *parent = below_sibling_layer->parent;
+  if (!parent) return;
+  if (layer_to_insert->parent) layer_remove_from_parent(layer_to_insert);
+  Layer **link = &parent->first_child;
+  while (*link != below_sibling_layer) link = &(*link)->next_sibling;
+  layer_to_insert->next_sibling = below_sibling_layer;
+  *link = layer_to_insert;
+  layer_to_insert->parent = parent;
+  layer_to_insert->dirty = true;
+}
+
+GRect layer_get_frame(const Layer *layer) {
+  return layer->frame;
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+  if (grect_equal(&layer->frame, &frame)) return;
+  layer->frame = frame;
+  layer->dirty = true;
+  if (layer->parent) layer->parent->dirty = true;
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+  return GRect(0, 0, layer->frame.size.w, layer->frame.size.h);
+}
+
+void layer_set_hidden(Layer *layer, bool hidden) {
+  if (layer->hidden == hidden) return;
+  layer->hidden = hidden;
+  layer->dirty = true;
+  if (layer->parent) layer->parent->dirty = true;
+}
+
+bool layer_get_hidden(const Layer *layer) {
+  return layer->hidden;
+}
+
+TextLayer *text_layer_create(GRect frame) {
+  TextLayer *text_layer = stub_malloc(sizeof(TextLayer));
+  if (!text_layer) return NULL;
+  memset(text_layer, 0, sizeof(*text_layer));
+  prv_layer_init(&text_layer->layer, frame, LAYER_KIND_TEXT);
+  text_layer->text_color = GColorBlack;
+  text_layer->background_color = GColorWhite;
+  text_layer->font = fonts_get_system_font("RESOURCE_ID_GOTHIC_14");
+  stub_stats.layers_created++;
+  return text_layer;
+}
+
+void text_layer_destroy(TextLayer *text_layer) {
+  if (!text_layer) return;
+  prv_layer_deinit(&text_layer->layer);
+  stub_stats.layers_destroyed++;
+  stub_free(text_layer);
+}
+
+Layer *text_layer_get_layer(TextLayer *text_layer) {
+  return &text_layer->layer;
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+  stub_stats.text_layer_set_text++;
+  text_layer->text = text;
+  text_layer->layer.dirty = true;
+}
+
+const char *text_layer_get_text(TextLayer *text_layer) {
+  return text_layer->text;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+  text_layer->background_color = color;
+  text_layer->layer.dirty = true;
+}
+
+void text_layer_set_text_color(TextLayer *text_layer, GColor color) {
+  stub_stats.text_layer_set_text_color++;
+  text_layer->text_color = color;
+  text_layer->layer.dirty = true;
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+  stub_stats.text_layer_set_font++;
+  text_layer->font = font;
+  text_layer->layer.dirty = true;
+}
+
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment text_alignment) {
+  text_layer->alignment = text_alignment;
+  text_layer->layer.dirty = true;
+}
+
+void text_layer_set_overflow_mode(TextLayer *text_layer, GTextOverflowMode line_mode) {
+  text_layer->layer.dirty = true;
+}
+
+// Windows
+
+Window *window_create(void) {
+  Window *window = stub_malloc(sizeof(Window));
+  if (!window) return NULL;
+  memset(window, 0, sizeof(*window));
+  prv_layer_init(&window->root, GRect(0, 0, SCREEN_W, SCREEN_H), LAYER_KIND_ROOT);
+  window->background_color = GColorWhite;
+  return window;
+}
+
+void window_destroy(Window *window) {
+  if (!window) return;
+  if (window->loaded && window->handlers.unload) window->handlers.unload(window);
+  window->loaded = false;
+  if (s_top_window == window) s_top_window = NULL;
+  prv_layer_deinit(&window->root);
+  stub_free(window);
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+void window_set_background_color(Window *window, GColor background_color) {
+  window->background_color = background_color;
+  window->root.dirty = true;
+}
+
+Layer *window_get_root_layer(const Window *window) {
+  return (Layer *)&window->root;
+}
+
+void window_stack_push(Window *window, bool animated) {
+  s_top_window = window;
+  if (!window->loaded && window->handlers.load) window->handlers.load(window);
+  window->loaded = true;
+  if (window->handlers.appear) window->handlers.appear(window);
+  window->root.dirty = true;
+}
+
+// Rendering
+
+static void prv_collect_dirty(Layer *layer, GPoint origin, GRect clip) {
+  if (layer->hidden) return;
+  GPoint abs = GPoint(origin.x + layer->frame.origin.x, origin.y + layer->frame.origin.y);
+  if (layer->kind == LAYER_KIND_ROOT) abs = origin;
+  if (layer->dirty) {
+    stub_stats.dirty_layers++;
+    int x0 = abs.x > clip.origin.x ? abs.x : clip.origin.x;
+    int x1 = abs.x + layer->frame.size.w;
+    if (x1 > clip.origin.x + clip.size.w) x1 = clip.origin.x + clip.size.w;
+    for (int y = abs.y; x1 > x0 && y < abs.y + layer->frame.size.h; y++) {
+      if (y < clip.origin.y || y >= clip.origin.y + clip.size.h) continue;
+      memset(&s_dirty_mask[y * SCREEN_W + x0], 1, x1 - x0);
+    }
+  }
+  for (Layer *c = layer->first_child; c; c = c->next_sibling) {
+    prv_collect_dirty(c, abs, clip);
+  }
+}
+
+static bool prv_any_dirty(const Layer *layer) {
+  if (layer->dirty) return true;
+  for (const Layer *c = layer->first_child; c; c = c->next_sibling) {
+    if (prv_any_dirty(c)) return true;
+  }
+  return false;
+}
+
+static void prv_render_layer(Layer *layer, GPoint origin, GRect clip) {
+  layer->dirty = false;
+  if (layer->hidden) return;
+  GPoint abs = GPoint(origin.x + layer->frame.origin.x, origin.y + layer->frame.origin.y);
+  if (layer->kind == LAYER_KIND_ROOT) abs = origin;
+
+  // Intersect the parent clip with this layer's frame
+  int x0 = abs.x > clip.origin.x ? abs.x : clip.origin.x;
+  int y0 = abs.y > clip.origin.y ? abs.y : clip.origin.y;
+  int x1 = abs.x + layer->frame.size.w;
+  int y1 = abs.y + layer->frame.size.h;
+  if (x1 > clip.origin.x + clip.size.w) x1 = clip.origin.x + clip.size.w;
+  if (y1 > clip.origin.y + clip.size.h) y1 = clip.origin.y + clip.size.h;
+  GRect layer_clip = GRect(x0, y0, x1 > x0 ? x1 - x0 : 0, y1 > y0 ? y1 - y0 : 0);
+
+  GContext ctx = {
+    .stroke_color = GColorBlack,
+    .fill_color = GColorBlack,
+    .text_color = GColorBlack,
+    .offset = abs,
+    .clip = layer_clip
+  };
+
+  if (layer->kind == LAYER_KIND_TEXT) {
+    TextLayer *text_layer = (TextLayer *)layer;
+    ctx.fill_color = text_layer->background_color;
+    graphics_fill_rect(&ctx, layer_get_bounds(layer), 0, GCornerNone);
+    ctx.text_color = text_layer->text_color;
+    graphics_draw_text(&ctx, text_layer->text, text_layer->font, layer_get_bounds(layer),
+                       GTextOverflowModeWordWrap, text_layer->alignment, NULL);
+  } else if (layer->update_proc) {
+    stub_stats.update_procs++;
+    layer->update_proc(layer, &ctx);
+  }
+
+  for (Layer *c = layer->first_child; c; c = c->next_sibling) {
+    prv_render_layer(c, abs, layer_clip);
+  }
+}
+
+bool stub_render(void) {
+  if (!s_top_window || !prv_any_dirty(&s_top_window->root)) return false;
+
+  const GRect screen = GRect(0, 0, SCREEN_W, SCREEN_H);
+  memset(s_dirty_mask, 0, sizeof(s_dirty_mask));
+  prv_collect_dirty(&s_top_window->root, GPointZero, screen);
+  for (size_t i = 0; i < SCREEN_W * SCREEN_H; i++) {
+    stub_stats.pixels_redrawn += s_dirty_mask[i];
+  }
+
+  for (size_t i = 0; i < SCREEN_W * SCREEN_H; i++) {
+    s_framebuffer[i] = s_top_window->background_color;
+  }
+  s_glyph_count = 0;
+  prv_render_layer(&s_top_window->root, GPointZero, screen);
+  stub_stats.frames_rendered++;
+  return true;
+}
+
+const GColor *stub_framebuffer(void) {
+  return s_framebuffer;
+}
+
+uint32_t stub_framebuffer_hash(void) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < SCREEN_W * SCREEN_H; i++) {
+    h ^= s_framebuffer[i].argb;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+const StubGlyph *stub_glyphs(size_t *count) {
+  *count = s_glyph_count;
+  return s_glyphs;
+}
+
+unsigned stub_live_layers(void) {
+  return s_live_layers;
+}
+
+// Persistent storage
+
+static int prv_persist_find(uint32_t key) {
+  for (int i = 0; i < MAX_PERSIST; i++) {
+    if (s_persist[i].used && s_persist[i].key == key) return i;
+  }
+  return -1;
+}
+
+void stub_persist_clear(void) {
+  memset(s_persist, 0, sizeof(s_persist));
+}
+
+bool persist_exists(const uint32_t key) {
+  return prv_persist_find(key) >= 0;
+}
+
+int persist_get_size(const uint32_t key) {
+  int i = prv_persist_find(key);
+  return i < 0 ? E_DOES_NOT_EXIST : (int)s_persist[i].size;
+}
+
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size) {
+  int i = prv_persist_find(key);
+  if (i < 0) return E_DOES_NOT_EXIST;
+  size_t n = s_persist[i].size < buffer_size ? s_persist[i].size : buffer_size;
+  memcpy(buffer, s_persist[i].data, n);
+  return (int)n;
+}
+
+int persist_write_data(const uint32_t key, const void *data, const size_t size) {
+  stub_stats.persist_writes++;
+  int i = prv_persist_find(key);
+  if (i < 0) {
+    for (i = 0; i < MAX_PERSIST && s_persist[i].used; i++) {}
+    if (i == MAX_PERSIST) return E_ERROR;
+  }
+  size_t n = size < sizeof(s_persist[i].data) ? size : sizeof(s_persist[i].data);
+  s_persist[i].used = true;
+  s_persist[i].key = key;
+  s_persist[i].size = n;
+  memcpy(s_persist[i].data, data, n);
+  return (int)n;
+}
+
+int32_t persist_read_int(const uint32_t key) {
+  int32_t value = 0;
+  persist_read_data(key, &value, sizeof(value));
+  return value;
+}
+
+status_t persist_write_int(const uint32_t key, const int32_t value) {
+  return persist_write_data(key, &value, sizeof(value)) < 0 ? E_ERROR : S_SUCCESS;
+}
+
+status_t persist_delete(const uint32_t key) {
+  int i = prv_persist_find(key);
+  if (i < 0) return E_DOES_NOT_EXIST;
+  s_persist[i].used = false;
+  return S_SUCCESS;
+}
+
+// AppMessage
+
+Tuple *dict_find(const DictionaryIterator *iter, const uint32_t key) {
+  for (size_t i = 0; i < iter->count; i++) {
+    if (iter->tuples[i].key == key) return &iter->tuples[i];
+  }
+  return NULL;
+}
+
+DictionaryResult dict_write_data(DictionaryIterator *iter, const uint32_t key, const uint8_t * const data,
+                                 const uint16_t size) {
+  if (!iter || (size > 0 && !data)) return DICT_INVALID_ARGS;
+  if (7 + size > s_outbox_free) return DICT_NOT_ENOUGH_STORAGE;
+  s_outbox_free -= 7 + size;
+  stub_stats.app_message_bytes += size;
+  return DICT_OK;
+}
+
+AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound) {
+  s_outbox_size = size_outbound;
+  return APP_MSG_OK;
+}
+
+AppMessageResult app_message_outbox_begin(DictionaryIterator **iterator) {
+  // Contents are only counted, not kept
+  static DictionaryIterator outbox;
+  s_outbox_free = s_outbox_size > 1 ? s_outbox_size - 1 : 0;
+  *iterator = &outbox;
+  return APP_MSG_OK;
+}
+
+AppMessageResult app_message_outbox_send(void) {
+  stub_stats.app_messages_sent++;
+  return APP_MSG_OK;
+}
+
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback) {
+  AppMessageInboxReceived previous = s_inbox_handler;
+  s_inbox_handler = received_callback;
+  return previous;
+}
+
+void stub_send_message(const uint32_t *keys, const int32_t *values, size_t count) {
+  if (!s_inbox_handler) return;
+  Tuple tuples[16];
+  if (count > 16) count = 16;
+  for (size_t i = 0; i < count; i++) {
+    tuples[i] = (Tuple) { .key = keys[i], .type = TUPLE_INT, .length = 4 };
+    tuples[i].value->int32 = values[i];
+  }
+  DictionaryIterator iter = { tuples, count };
+  s_inbox_handler(&iter, NULL);
+}
+
+// Event loop
+
+void stub_set_event_loop(void (*loop)(void)) {
+  s_event_loop = loop;
+}
+
+void app_event_loop(void) {
+  if (s_event_loop) s_event_loop();
+}
+
+void stub_stats_reset(void) {
+  memset(&stub_stats, 0, sizeof(stub_stats));
+}
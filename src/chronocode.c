@@ -8,6 +8,11 @@
  */
 #include <pebble.h>
 #include "chronocode.h"
+#ifdef GLYPH_ATLAS_RENDERER
+#include "glyph_atlas.h"
+#endif
+#include "pack_reader.h"
+#include "perf.h"
 
 enum { LAYER_FILLER = 27 };
 
@@ -18,51 +23,113 @@ enum { LAYER_FILLER = 27 };
 typedef struct {
   uint8_t row; /**< The row coordinate of the word's first letter */
   uint8_t col; /**< The column coordinate of the word's first letter */
-  char text_on[16];  /**< The string to display when the word is "on" */
-  char text_off[16]; /**< The string to display when the word is "off" */
+  uint8_t width; /**< The width of the word in grid cells (characters, not bytes) */
+  uint16_t text_on;  /**< Offset in word_text of the string to display when the word is "on" */
+  uint16_t text_off; /**< Offset in word_text of the string to display when the word is "off" */
 } word_t;
 
 static Window *window; /**< The Pebble window */
-static TextLayer *text_layers[54]; /**< Array of text layers for displaying the words */
-static GFont font_on;  /**< The font used for words that are inactive or "off" */
-static GFont font_off; /**< The font used for words that are active or "on" */
-static Layer *minute_layer; /**< The layer onto which is drawn the box/dot representing the minute_num */
+#ifdef SINGLE_LAYER_RENDERER
+static Layer *word_layer; /**< The layer onto which all of the words are drawn */
+#else
+static TextLayer **text_layers; /**< Array of text layers for displaying the words (text_layer_count entries) */
+static uint8_t text_layer_count; /**< Entries in text_layers: word_count, or fewer if memory ran out */
+#endif
+static GFont font_on;  /**< The font used for words that are active or "on" */
+static GFont font_off; /**< The font used for words that are inactive or "off" (the same handle as font_on if FONT_OFF is FONT_ON) */
+#ifdef GLYPH_ATLAS_RENDERER
+static GlyphAtlas *glyph_atlas; /**< Pre-rendered glyphs, or NULL if the fonts are used instead */
+#endif
+static Layer *minute_layers[4]; /**< The corner layers onto which are drawn the boxes/dots representing the minute_num */
 static int minute_num; /**< The number of minutes (1-4) since the last five minute interval */
 static ChronoCodeSettings settings; /**< Current settings */
+static ChronoCodeSettings persisted_settings; /**< Settings as last read from or written to persistent storage */
 static uint8_t flags; /**< Current flags (as bit flags) */
-static const uint8_t word_count = 54;
+static uint64_t lit_words; /**< Bitmap of the words currently displayed as "on" (bit N is word N) */
+static uint8_t word_count = 1; /**< Number of words in the current language, including the unused word 0 */
 
 /**
  * Array of word_t structs required to create all the phrases for displaying the time.
  *
+ * Allocated with word_count entries for the current language. Word 0 is never
+ * displayed, so that word N is bit N of the lit-word bitmaps.
  */
-static word_t mywords[54];
+static word_t *mywords;
 
 /**
- * Interval logic array
- *
- * Twelve five-minute intervals (e.g., 0-4, 5-9, 10-14, etc.).
- * Index 0 is for indicating the "always on" or permanent words (e.g., "It is").
- * Each index after that is for indicating the enabled words for successive
- * five-minute intervals, e.g. index 1 is fo 0-4, index 2 is for 5-9, etc.
- *
- * Each interval has a five element array. The first element (index 0) holds
- * the value to be added to the current hour, usually (always?) 0 or 1. This
- * value is used for many languages which refer to the next hour when it is
- * more than 30 minutes past the current hour.
+ * The NUL-terminated texts of the words, allocated to fit the current
+ * language. Offset 0 is always an empty string.
+ */
+static char *word_text;
+
+/**
+ * Resource handle of the language packs, which hold every language in a
+ * single resource (see cclp/src/cclp.c).
  *
- * The next four elements of an interval array are for indicating up to four
- * words to be enabled to display the current time.
+ * Besides the words, each pack holds a table of the words to be lit for every
+ * hour and five-minute interval, with all language-specific rules already
+ * applied by the packer. The table is read one entry at a time when needed;
+ * it is never compressed, so that is always a single resource read.
  *
+ * The table has 288 entries of eight bytes each (little-endian bitmaps, bit N
+ * is word N), ordered by the "rounded" flag, then hour (1-12), then interval
+ * (1-12). The "rounded" half of the table is used when the "two-minute dots"
+ * setting has rounded the time up to the next five-minute interval.
  */
-static uint8_t intervals[13][5];
+static ResHandle language_handle;
+static uint32_t lit_table_offset; /**< Byte offset of the current language's lit-word table in the resource */
+static int16_t lit_slot = -1; /**< Lit-word table entry of lit_words, or -1 if it must be looked up again */
+
+enum {
+  PACK_VERSION = 6,           /**< Supported language pack format version (see cclp/src/cclp.c) */
+  PACKS_HEADER_SIZE = 18,     /**< Bytes in the header of the language packs resource */
+  INDEX_ENTRY_SIZE = 6,       /**< Bytes per language in the index of the language packs resource */
+  PACK_HEADER_SIZE = 8,       /**< Bytes in a language pack header */
+  PACK_RAW = 0,               /**< Encodings of the word entries of a language pack */
+  PACK_COMPRESSED = 1,
+  WORD_ENTRY_SIZE = 7,        /**< Bytes per word entry in a language pack */
+  TEXT_DERIVED = 0xFFFF,      /**< Text offset of a text_off derived from text_on */
+  LIT_TABLE_ENTRY_SIZE = 8,   /**< Bytes per lit-word table entry */
+  LIT_TABLE_SIZE = 2 * 12 * 12 * LIT_TABLE_ENTRY_SIZE, /**< Bytes in the lit-word table */
+  CRC_CHUNK_SIZE = 64         /**< Bytes read at a time when checking the lit-word table */
+};
+
+// Corners of the screen, in the order the minute boxes are lit
+enum {
+  CORNER_TOP_LEFT,
+  CORNER_TOP_RIGHT,
+  CORNER_BOTTOM_RIGHT,
+  CORNER_BOTTOM_LEFT,
+  CORNER_COUNT
+};
+
+// Marks drawn in a corner by the minute indicator
+enum {
+  MARK_NONE,
+  MARK_BOX,  /**< A filled box (one box per minute) */
+  MARK_DOT,  /**< A filled dot (two-minute dots, before the interval) */
+  MARK_RING  /**< An outlined dot (two-minute dots, after the interval) */
+};
+
+enum { MINUTE_MARK_SIZE = 4 }; /**< Width and height of a corner layer of the minute indicator */
 
 // Forward declarations
+static GRect prv_word_frame(int which);
+static const char *prv_word_text(int which, int on);
+static GColor prv_word_color(int on);
+#ifndef SINGLE_LAYER_RENDERER
 static void prv_toggle_word(int which, int on);
+#endif
+static uint64_t prv_load_lit_words(unsigned slot);
 static void prv_update_display(struct tm *time);
 static void prv_update_display_now(void);
 static void prv_load_language_from_resource_file(void);
+#ifdef SINGLE_LAYER_RENDERER
+static void prv_word_layer_update_callback(Layer * const me, GContext * ctx);
+#else
 static void prv_word_layer_init(int which);
+#endif
+static void prv_set_minute_num(int num);
 static void prv_minute_layer_update_callback(Layer * const me, GContext * ctx);
 static void prv_handle_minute_tick(struct tm *tick_time, TimeUnits units_changed);
 
@@ -81,6 +148,7 @@ static void prv_load_settings() {
   if (persist_exists(SETTINGS_KEY)) {
     persist_read_data(SETTINGS_KEY, &settings, sizeof(settings));
   }
+  persisted_settings = settings;
 
   // Convert settings to flags
   flags = (settings.allCaps ? SETTING_ALL_CAPS : 0) |
@@ -90,9 +158,15 @@ static void prv_load_settings() {
 
 /**
  * Store settings for seamless rehydration
+ *
+ * Settings are only written if they differ from those already stored, as
+ * the phone sends every setting whenever any of them is changed.
  */
 static void prv_save_settings() {
-  persist_write_data(SETTINGS_KEY, &settings, sizeof(settings));
+  if (memcmp(&settings, &persisted_settings, sizeof(settings)) != 0) {
+    persist_write_data(SETTINGS_KEY, &settings, sizeof(settings));
+    persisted_settings = settings;
+  }
 
   // Update flags from settings
   flags = (settings.allCaps ? SETTING_ALL_CAPS : 0) |
@@ -100,6 +174,52 @@ static void prv_save_settings() {
           (settings.twoMinDots ? SETTING_TWO_MIN_DOTS : 0);
 }
 
+/**
+ * Get the frame in which a word is displayed.
+ *
+ * @param which The index of the word
+ */
+static GRect prv_word_frame(int which) {
+  const word_t * const w = &mywords[which];
+
+  // Grid metrics depend on the screen (see chronocode.h)
+  return GRect(
+    GRID_X + w->col * FONT_W,
+    GRID_Y + w->row * FONT_H + WORD_Y,
+    w->width * FONT_W + 4, // a little slack for glyphs overhanging their advance
+    WORD_H
+  );
+}
+
+/**
+ * Get the text to display for a word.
+ *
+ * @param which The index of the word
+ * @param on    On/off state of the word
+ */
+static const char *prv_word_text(int which, int on) {
+  const word_t * const w = &mywords[which];
+  if (!word_text) return ""; // No valid language pack
+  return &word_text[on || (flags & SETTING_ALL_CAPS) > 0 ? w->text_on : w->text_off];
+}
+
+/**
+ * Get the color in which to display a word.
+ *
+ * @param on On/off state of the word
+ */
+static GColor prv_word_color(int on) {
+  #ifdef PBL_COLOR
+  if ((flags & SETTING_INVERTED) > 0) {
+    return on ? GColorBlack : GColorLightGray;
+  }
+  return on ? GColorWhite : GColorDarkGray;
+  #else
+  return (flags & SETTING_INVERTED) > 0 ? GColorBlack : GColorWhite;
+  #endif
+}
+
+#ifndef SINGLE_LAYER_RENDERER
 /**
  * Toggle the on/off state of a single word.
  *
@@ -108,136 +228,96 @@ static void prv_save_settings() {
  */
 static void prv_toggle_word(int which, int on) {
   if (which == 0) return;
-  const word_t * const w = &mywords[which];
 
-  text_layer_set_text(text_layers[which], on ? w->text_on : ((flags & SETTING_ALL_CAPS) > 0 ? w->text_on : w->text_off));
-  text_layer_set_font(text_layers[which], on ? font_on : font_off);
+  text_layer_set_text(text_layers[which], prv_word_text(which, on));
+  if (font_on != font_off) {
+    text_layer_set_font(text_layers[which], on ? font_on : font_off);
+  }
 
   #ifdef PBL_COLOR
-  if ((flags & SETTING_INVERTED) > 0) {
-    text_layer_set_text_color(text_layers[which], on ? GColorBlack : GColorLightGray);
-  } else {
-    text_layer_set_text_color(text_layers[which], on ? GColorWhite : GColorDarkGray);
-  }
+  text_layer_set_text_color(text_layers[which], prv_word_color(on));
   #endif
 }
+#endif
+
+/**
+ * Look up the words to be lit for a time in the language pack's lit-word table.
+ *
+ * @param slot The table entry: ((rounded ? 12 : 0) + (hour - 1)) * 12 + (interval - 1)
+ * @return Bitmap of the words to be lit (bit N is word N)
+ */
+static uint64_t prv_load_lit_words(unsigned slot) {
+  uint8_t buffer[LIT_TABLE_ENTRY_SIZE];
+  uint64_t lit = 0;
+
+  if (!language_handle) return 0; // No valid language pack
+
+  resource_load_byte_range(language_handle, lit_table_offset + slot * LIT_TABLE_ENTRY_SIZE, buffer, sizeof(buffer));
+  for (int i = LIT_TABLE_ENTRY_SIZE - 1; i >= 0; i--) {
+    lit = (lit << 8) | buffer[i];
+  }
+  return lit;
+}
 
 /**
  * Update time display.
  *
+ * Looks up the words needed for the given time, then toggles only the words
+ * whose state differs from what is currently displayed. If the hour and
+ * five-minute interval are those already displayed, as on four ticks out of
+ * five, only the minute indicator is updated.
+ *
  * @param time The time to be displayed
  */
 static void prv_update_display(struct tm *time) {
+  PERF_START(start_ms);
   int hour = time->tm_hour;
   const int min = time->tm_min;
   uint8_t interval_idx = (min / 5) + 1;
+  bool rounded = false;
 
   // Two-minute dot intervals?
   if ((flags & SETTING_TWO_MIN_DOTS) > 0) {
     interval_idx = (int)((min + 2.5) / 5) + 1;
+    rounded = (min % 5) > 2;
     if (interval_idx > 12) {
       interval_idx = 1;
       hour++;
     }
   }
 
-  // Turn off all of the words
-  for (unsigned i = 0; i < word_count; i++) {
-    prv_toggle_word(i, 0);
-  }
-
-  // Toggle permanent words
-  prv_toggle_word(intervals[0][1], 1);
-  prv_toggle_word(intervals[0][2], 1);
-  prv_toggle_word(intervals[0][3], 1);
-  prv_toggle_word(intervals[0][4], 1);
-
-  // Toggle interval words
-  prv_toggle_word(intervals[interval_idx][1], 1);
-  prv_toggle_word(intervals[interval_idx][2], 1);
-  prv_toggle_word(intervals[interval_idx][3], 1);
-  prv_toggle_word(intervals[interval_idx][4], 1);
-
   // Update the minute box
-  minute_num = min % 5;
-  layer_mark_dirty(minute_layer);
-
-  // Refer to current hour or next hour?
-  if (intervals[interval_idx][0]) {
-    if (++hour > 24) hour = 0;
-  }
+  prv_set_minute_num(min % 5);
 
   // Convert from 24-hour to 12-hour time
+  hour %= 12;
   if (hour == 0) hour = 12;
-  else if (hour > 12) hour -= 12;
 
-  // Turn on the word needed for the current hour, turn off the others
-  for (int h = 1; h <= 12; h++) {
-    prv_toggle_word(h, h == hour ? 1 : 0);
+  // Nothing else to do if the words are already those of this slot
+  const int16_t slot = ((rounded ? 12 : 0) + (hour - 1)) * 12 + (interval_idx - 1);
+  if (slot == lit_slot) {
+    PERF_END(PERF_UPDATE_DISPLAY, start_ms);
+    return;
   }
 
-  // Special circumstances for various languages
-  if (LANG_DE_DE == settings.language) {
-    if (hour == 1 && min >= 5) {
-      prv_toggle_word(1, 0);
-      prv_toggle_word(13, 1);
-    } else {
-      prv_toggle_word(13, 0);
-    }
-  } else if (LANG_ES_ES == settings.language) {
-    if (hour == 1) {
-      prv_toggle_word(13, 1);
-      prv_toggle_word(14, 1);
-    } else {
-      prv_toggle_word(15, 1);
-      prv_toggle_word(16, 1);
-    }
-  } else if (LANG_FR_FR == settings.language) {
-    if (hour == 1) {
-      prv_toggle_word(24, 1);
-    } else {
-      prv_toggle_word(25, 1);
-    }
-  } else if (LANG_IT_IT == settings.language) {
-    if (hour == 1) {
-      prv_toggle_word(13, 1);
-    } else {
-      prv_toggle_word(14, 1);
-      prv_toggle_word(15, 1);
-    }
-  } else if (LANG_PT_PT == settings.language) {
-    if (hour == 1) {
-      prv_toggle_word(13, 1);
-    } else {
-      prv_toggle_word(14, 1);
-      if (hour == 2) {
-        prv_toggle_word(15, 1); // S
-      } else if (hour == 4) {
-        prv_toggle_word(16, 1); // O
-      } else if (hour == 6) {
-        prv_toggle_word(17, 1); // I
-      } else if (hour == 7) {
-        prv_toggle_word(15, 1); // S
-        prv_toggle_word(18, 1); // T
-      } else if (hour == 8) {
-        prv_toggle_word(16, 1); // O
-        prv_toggle_word(17, 1); // I
-        prv_toggle_word(18, 1); // T
-        prv_toggle_word(19, 1); // O
-      } else if (hour == 11) {
-        prv_toggle_word(16, 1); // O
-      } else if (hour == 12) {
-        prv_toggle_word(19, 1); // O
-      }
-    }
-
-    if (min > 30 && hour > 1) {
-      prv_toggle_word(33, 1); // A
-      if (hour != 6 && hour != 7) {
-        prv_toggle_word(34, 1); // S
-      }
+  // Only touch the words whose state has changed
+  const uint64_t lit = prv_load_lit_words(slot);
+  const uint64_t changed = lit ^ lit_words;
+#ifdef SINGLE_LAYER_RENDERER
+  if (changed) {
+    layer_mark_dirty(word_layer);
+  }
+#else
+  for (uint64_t bits = changed; bits; bits &= bits - 1) {
+    const unsigned i = __builtin_ctzll(bits);
+    if (i < text_layer_count) {
+      prv_toggle_word(i, (lit >> i) & 1);
     }
   }
+#endif
+  lit_words = lit;
+  lit_slot = slot;
+  PERF_END(PERF_UPDATE_DISPLAY, start_ms);
 }
 
 /**
@@ -260,144 +340,509 @@ static void prv_handle_minute_tick(struct tm *tick_time, TimeUnits units_changed
 }
 
 /**
- * Draws a box in a corner of the screen to indicate the number of minutes past the five.
+ * Get the mark drawn in a corner of the screen for a number of minutes past the five.
  *
- * @param me  Pointer to layer to be rendered
+ * @param corner The corner (CORNER_*)
+ * @param num    The number of minutes (0-4)
+ * @return The mark (MARK_*)
+ */
+static uint8_t prv_corner_mark(int corner, int num) {
+  if (num == 0) return MARK_NONE;
+
+  if ((flags & SETTING_TWO_MIN_DOTS) == 0) {
+    return corner == num - 1 ? MARK_BOX : MARK_NONE;
+  }
+  switch (num) {
+    case 1: return corner == CORNER_BOTTOM_LEFT ? MARK_DOT : MARK_NONE;
+    case 2: return corner == CORNER_BOTTOM_LEFT || corner == CORNER_BOTTOM_RIGHT ? MARK_DOT : MARK_NONE;
+    case 3: return corner == CORNER_TOP_LEFT || corner == CORNER_TOP_RIGHT ? MARK_RING : MARK_NONE;
+    default: return corner == CORNER_TOP_LEFT ? MARK_RING : MARK_NONE;
+  }
+}
+
+/**
+ * Set the number of minutes shown by the minute indicator.
+ *
+ * Only the corners whose mark changes are marked dirty, so most ticks redraw
+ * one or two 4x4 corners rather than the whole screen.
+ *
+ * @param num The number of minutes (0-4)
+ */
+static void prv_set_minute_num(int num) {
+  for (int i = 0; i < CORNER_COUNT; i++) {
+    if (prv_corner_mark(i, num) != prv_corner_mark(i, minute_num)) {
+      layer_mark_dirty(minute_layers[i]);
+    }
+  }
+  minute_num = num;
+}
+
+/**
+ * Draws the box/dot, if any, in one corner of the screen to indicate the number of minutes past the five.
+ *
+ * @param me  Pointer to layer to be rendered (one of minute_layers)
  * @param ctx The destination graphics context to draw into
  */
 static void prv_minute_layer_update_callback(Layer * const me, GContext * ctx) {
-  if (minute_num == 0) return; // Nothing to draw
+  const int corner = *(uint8_t *)layer_get_data(me);
+  const uint8_t mark = prv_corner_mark(corner, minute_num);
+  if (mark == MARK_NONE) return; // Nothing to draw
+  PERF_START(start_ms);
 
   graphics_context_set_stroke_color(ctx, (flags & SETTING_INVERTED) > 0 ? GColorBlack : GColorWhite);
   graphics_context_set_fill_color(ctx, (flags & SETTING_INVERTED) > 0 ? GColorBlack : GColorWhite);
 
   GRect bounds = layer_get_bounds(me);
-  int screen_w = bounds.size.w;
-  int screen_h = bounds.size.h;
-
-  if ((flags & SETTING_TWO_MIN_DOTS) > 0) {
+  if (mark == MARK_BOX) {
+    graphics_fill_rect(ctx, bounds, 1, GCornersAll);
+  } else {
+    // Dots sit against the screen edges of the corner
     const uint16_t r = 1; // Radius of dot to be drawn
-    if (minute_num == 1) {
-      graphics_fill_circle(ctx, GPoint(r, screen_h - 2*r), r);
-    } else if (minute_num == 2) {
-      graphics_fill_circle(ctx, GPoint(r, screen_h - 2*r), r);
-      graphics_fill_circle(ctx, GPoint(screen_w - 2*r, screen_h - 2*r), r);
-    } else if (minute_num == 3) {
-      graphics_draw_circle(ctx, GPoint(screen_w - 2*r, r), r);
-      graphics_draw_circle(ctx, GPoint(r, r), r);
-    } else if (minute_num == 4) {
-      graphics_draw_circle(ctx, GPoint(r, r), r);
+    const bool right = corner == CORNER_TOP_RIGHT || corner == CORNER_BOTTOM_RIGHT;
+    const bool bottom = corner == CORNER_BOTTOM_LEFT || corner == CORNER_BOTTOM_RIGHT;
+    const GPoint center = GPoint(right ? bounds.size.w - 2*r : r, bottom ? bounds.size.h - 2*r : r);
+    if (mark == MARK_DOT) {
+      graphics_fill_circle(ctx, center, r);
+    } else {
+      graphics_draw_circle(ctx, center, r);
     }
-  } else {
-    const int w = 4; // Width of the box to be drawn
-    GRect box = GRect(0, 0, w, w);
-    if (minute_num == 1) box.origin = GPoint(0, 0); // top-left corner
-    else if (minute_num == 2) box.origin = GPoint(screen_w - w, 0); // top-right corner
-    else if (minute_num == 3) box.origin = GPoint(screen_w - w, screen_h - w); // bottom-right corner
-    else if (minute_num == 4) box.origin = GPoint(0, screen_h - w); // bottom-left corner
-    graphics_fill_rect(ctx, box, 1, GCornersAll);
   }
+  PERF_END(PERF_MINUTE_LAYER_UPDATE, start_ms);
 }
 
+#ifdef SINGLE_LAYER_RENDERER
+/**
+ * Draws all of the words, each in its on/off state.
+ *
+ * Words are drawn in index order, so overlapping words are painted in the
+ * same order as their TextLayers would be.
+ *
+ * @param me  Pointer to layer to be rendered
+ * @param ctx The destination graphics context to draw into
+ */
+static void prv_word_layer_update_callback(Layer * const me, GContext * ctx) {
+  PERF_START(start_ms);
+#ifdef GLYPH_ATLAS_RENDERER
+  // The word layer covers the whole window, so word frames are already in
+  // frame buffer coordinates
+  GBitmap *fb = glyph_atlas ? graphics_capture_frame_buffer(ctx) : NULL;
+  if (fb) {
+    for (unsigned i = 1; i < word_count; i++) {
+      const int on = (lit_words >> i) & 1;
+      glyph_atlas_draw_text(glyph_atlas, fb, prv_word_text(i, on), prv_word_frame(i).origin,
+                            on ? GLYPH_WEIGHT_ON : GLYPH_WEIGHT_OFF, prv_word_color(on));
+    }
+    graphics_release_frame_buffer(ctx, fb);
+    PERF_END(PERF_WORD_LAYER_UPDATE, start_ms);
+    return;
+  }
+#endif
+  for (unsigned i = 1; i < word_count; i++) {
+    const int on = (lit_words >> i) & 1;
+    graphics_context_set_text_color(ctx, prv_word_color(on));
+    graphics_draw_text(ctx, prv_word_text(i, on), on ? font_on : font_off, prv_word_frame(i),
+                       GTextOverflowModeWordWrap, GTextAlignmentLeft, NULL);
+  }
+  PERF_END(PERF_WORD_LAYER_UPDATE, start_ms);
+}
+#else
 /**
  * Initialize TextLayer for displaying a single word.
  *
  * @param which The index of the word to be displayed by the new layer
  */
 static void prv_word_layer_init(int which) {
-  const word_t * const w = &mywords[which];
-
-  // 144x168 aplite, basalt, diorite, flint
-  // 180x180 chalk
-  // 200x228 emery
-  // 260x260 gabbro
-  GRect frame = GRect(
-    w->col * FONT_W,
-    w->row * FONT_H - 2,
-    strlen(w->text_on) * (FONT_W + 4),
-    FONT_H + 8
-  );
-
-  text_layers[which] = text_layer_create(frame);
-  text_layer_set_text_color(text_layers[which], (flags & SETTING_INVERTED) > 0 ? GColorBlack : GColorWhite);
+  text_layers[which] = text_layer_create(prv_word_frame(which));
+  text_layer_set_text_color(text_layers[which], prv_word_color(0));
   text_layer_set_background_color(text_layers[which], GColorClear);
   text_layer_set_font(text_layers[which], font_off);
-  Layer *window_layer = window_get_root_layer(window);
-  layer_add_child(window_layer, text_layer_get_layer(text_layers[which]));
+  if (minute_layers[0]) {
+    // Keep the minute indicator on top of words added for a new language
+    layer_insert_below_sibling(text_layer_get_layer(text_layers[which]), minute_layers[0]);
+  } else {
+    Layer *window_layer = window_get_root_layer(window);
+    layer_add_child(window_layer, text_layer_get_layer(text_layers[which]));
+  }
   prv_toggle_word(which, 0); // all are "off" initially
 }
 
 /**
- * Clear the watchface by destroying and recreating all text layers
+ * Match the text layers to the words of a newly loaded language.
+ *
+ * Existing layers are re-framed for their new words; layers are only created
+ * or destroyed if the new language has more or fewer words. If the array
+ * cannot grow, the old one is kept and the words without a layer are not
+ * shown.
+ */
+static void prv_resize_text_layers(void) {
+  const uint8_t old_count = text_layer_count;
+  for (unsigned i = word_count; i < old_count; i++) {
+    text_layer_destroy(text_layers[i]);
+  }
+  if (word_count != old_count) {
+    TextLayer ** const layers = realloc(text_layers, word_count * sizeof(*text_layers));
+    if (layers) {
+      text_layers = layers;
+      text_layer_count = word_count;
+    } else {
+      APP_LOG(APP_LOG_LEVEL_ERROR, "No memory for %d text layers", word_count);
+      if (word_count < old_count) text_layer_count = word_count;
+    }
+  }
+  for (unsigned i = 1; i < text_layer_count; i++) {
+    if (i < old_count) {
+      layer_set_frame(text_layer_get_layer(text_layers[i]), prv_word_frame(i));
+    } else {
+      prv_word_layer_init(i);
+    }
+  }
+}
+#endif
+
+/**
+ * Create the layers displaying the words and the minute indicator.
  *
  */
-static void prv_clear_watchface() {
+static void prv_create_layers(void) {
   Layer *window_layer = window_get_root_layer(window);
   GRect bounds = layer_get_bounds(window_layer);
 
-  //  Destroy existing text layers
-  for (unsigned i = 0; i < word_count; i++) {
+  // Set background color
+  window_set_background_color(window, (flags & SETTING_INVERTED) > 0 ? GColorWhite : GColorBlack);
+
+  // Initialize text layers for displaying words
+#ifdef SINGLE_LAYER_RENDERER
+  word_layer = layer_create(bounds);
+  layer_set_update_proc(word_layer, prv_word_layer_update_callback);
+  layer_add_child(window_layer, word_layer);
+#else
+  text_layers = calloc(word_count, sizeof(*text_layers));
+  text_layer_count = text_layers ? word_count : 0;
+  if (!text_layers) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "No memory for %d text layers", word_count);
+  }
+  for (unsigned i = 1; i < text_layer_count; i++) {
+    prv_word_layer_init(i);
+  }
+#endif
+  lit_words = 0;
+  lit_slot = -1;
+
+  // Initialize a small graphics layer in each corner for the minute indicator
+  for (int i = 0; i < CORNER_COUNT; i++) {
+    const bool right = i == CORNER_TOP_RIGHT || i == CORNER_BOTTOM_RIGHT;
+    const bool bottom = i == CORNER_BOTTOM_LEFT || i == CORNER_BOTTOM_RIGHT;
+    minute_layers[i] = layer_create_with_data(GRect(right ? bounds.size.w - MINUTE_INSET_X - MINUTE_MARK_SIZE : MINUTE_INSET_X,
+                                                    bottom ? bounds.size.h - MINUTE_INSET_Y - MINUTE_MARK_SIZE : MINUTE_INSET_Y,
+                                                    MINUTE_MARK_SIZE, MINUTE_MARK_SIZE), sizeof(uint8_t));
+    *(uint8_t *)layer_get_data(minute_layers[i]) = i;
+    layer_set_update_proc(minute_layers[i], prv_minute_layer_update_callback);
+    layer_add_child(window_layer, minute_layers[i]);
+  }
+}
+
+/**
+ * Destroy the layers created by prv_create_layers().
+ *
+ */
+static void prv_destroy_layers(void) {
+#ifdef SINGLE_LAYER_RENDERER
+  layer_destroy(word_layer);
+#else
+  for (unsigned i = 1; i < text_layer_count; i++) {
     text_layer_destroy(text_layers[i]);
   }
-  layer_destroy(minute_layer);
+  free(text_layers);
+  text_layers = NULL;
+  text_layer_count = 0;
+#endif
+  for (int i = 0; i < CORNER_COUNT; i++) {
+    layer_destroy(minute_layers[i]);
+    minute_layers[i] = NULL;
+  }
+}
 
-  // Set background color
+/**
+ * Apply the current settings to the existing layers.
+ *
+ * Re-texts and recolors the words in their current on/off state, without
+ * recreating any layers.
+ */
+static void prv_restyle(void) {
   window_set_background_color(window, (flags & SETTING_INVERTED) > 0 ? GColorWhite : GColorBlack);
 
-  // Create new text layers
-  for (unsigned i = 0; i < word_count; i++) {
-    prv_word_layer_init(i);
+#ifdef SINGLE_LAYER_RENDERER
+  layer_mark_dirty(word_layer);
+#else
+  for (unsigned i = 1; i < text_layer_count; i++) {
+    const int on = (lit_words >> i) & 1;
+    #ifndef PBL_COLOR
+    // Only set per state on color platforms, but inverting changes it here too
+    text_layer_set_text_color(text_layers[i], prv_word_color(on));
+    #endif
+    prv_toggle_word(i, on);
   }
-  minute_layer = layer_create(GRect(0, 0, bounds.size.w, bounds.size.h));
-  layer_set_update_proc(minute_layer, prv_minute_layer_update_callback);
-  layer_add_child(window_layer, minute_layer);
+#endif
+  for (int i = 0; i < CORNER_COUNT; i++) {
+    layer_mark_dirty(minute_layers[i]);
+  }
+}
+
+static uint16_t prv_read_u16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+
+static uint32_t prv_read_u32(const uint8_t *p) {
+  return prv_read_u16(p) | ((uint32_t)prv_read_u16(&p[2]) << 16);
+}
+
+/**
+ * Compute the CRC-32 (IEEE 802.3) of a block of data.
+ *
+ * @param crc The CRC-32 of the data preceding the block, or 0
+ */
+static uint32_t prv_crc32(uint32_t crc, const uint8_t *data, size_t size) {
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+/**
+ * Compute the CRC-32 of a byte range of a resource, reading it in small
+ * chunks rather than into a buffer of its size.
+ *
+ * @param crc The CRC-32 of the data preceding the range, or 0
+ */
+static uint32_t prv_resource_crc32(ResHandle handle, uint32_t offset, size_t size, uint32_t crc) {
+  uint8_t chunk[CRC_CHUNK_SIZE];
+  while (size > 0) {
+    const size_t n = size < sizeof(chunk) ? size : sizeof(chunk);
+    resource_load_byte_range(handle, offset, chunk, n);
+    crc = prv_crc32(crc, chunk, n);
+    offset += n;
+    size -= n;
+  }
+  return crc;
+}
+
+/**
+ * Check that a language pack is intact and that everything in it is in range.
+ *
+ * @param handle The language packs resource
+ * @param header The header of the resource
+ * @param pool   The string pool
+ * @param pack   The start of the language's pack: its header and decoded word entries
+ * @param table  Offset of the language's lit-word table in the resource
+ * @return True if the pack can be used
+ */
+static bool prv_validate_language_pack(ResHandle handle, const uint8_t *header, const uint8_t *pool,
+                                       const uint8_t *pack, uint32_t table) {
+  const uint16_t pool_size = prv_read_u16(&header[8]);
+  const uint8_t count = pack[0];
+  const uint8_t cols = pack[1];
+  const uint8_t rows = pack[2];
+  const uint16_t entries_size = count * WORD_ENTRY_SIZE;
+
+  if (prv_crc32(0, pool, pool_size) != prv_read_u32(&header[10])) return false;
+  // The lit-word table is not kept in RAM, so it is read again for the CRC
+  const uint32_t crc = prv_crc32(0, &pack[PACK_HEADER_SIZE], entries_size);
+  if (prv_resource_crc32(handle, table, LIT_TABLE_SIZE, crc) != prv_read_u32(&pack[4])) return false;
+
+  for (uint8_t i = 0; i < count; i++) {
+    const uint8_t * const e = &pack[PACK_HEADER_SIZE + i * WORD_ENTRY_SIZE];
+    const uint16_t off = prv_read_u16(&e[4]);
+    if ((e[0] >> 4) >= rows || (e[0] & 0x0F) >= cols || (e[0] & 0x0F) + e[6] > cols ||
+        prv_read_u16(&e[2]) + (e[1] >> 4) > pool_size ||
+        (off != TEXT_DERIVED && off + (e[1] & 0x0F) > pool_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Load and unpack a language's pack.
+ *
+ * The header of the language packs resource and the language's index entry
+ * are read first to find the pack. The shared string pool and the pack's word
+ * entries, decoded while they are read if they are compressed, are then
+ * validated before anything is taken from them; the lit-word table, at the
+ * end of the pack, stays in the resource. The texts are unpacked into
+ * word_text as NUL-terminated strings. Texts shown when a word is "off" are
+ * usually just the "on" text in lowercase, so the pack only stores them when
+ * they are not.
+ *
+ * @param language The language ID
+ * @return True if the pack was valid and loaded
+ */
+static bool prv_load_language_pack(uint8_t language) {
+  const ResHandle handle = resource_get_handle(RESOURCE_ID_CHRONOCODE_PACKS);
+  const size_t size = resource_size(handle);
+  uint8_t header[PACKS_HEADER_SIZE];
+  uint8_t index_entry[INDEX_ENTRY_SIZE];
+  uint8_t pack_header[PACK_HEADER_SIZE];
+
+  if (size < PACKS_HEADER_SIZE) return false;
+  resource_load_byte_range(handle, 0, header, sizeof(header));
+  if (memcmp(header, "CCLP", 4) != 0 || header[4] != PACK_VERSION || language >= header[5] ||
+      prv_read_u32(&header[14]) != size) {
+    return false;
+  }
+  const uint16_t pool_offset = prv_read_u16(&header[6]);
+  const uint16_t pool_size = prv_read_u16(&header[8]);
+  resource_load_byte_range(handle, PACKS_HEADER_SIZE + language * INDEX_ENTRY_SIZE, index_entry, sizeof(index_entry));
+  const uint32_t offset = prv_read_u32(index_entry);
+  const uint16_t pack_size = prv_read_u16(&index_entry[4]);
+  if (pool_offset < PACKS_HEADER_SIZE + header[5] * INDEX_ENTRY_SIZE || pool_offset + pool_size > size ||
+      pack_size < PACK_HEADER_SIZE + LIT_TABLE_SIZE || offset + pack_size > size) {
+    return false;
+  }
+  resource_load_byte_range(handle, offset, pack_header, sizeof(pack_header));
+  if (pack_header[0] > 63 || pack_header[1] > 16 || pack_header[2] > 16 ||
+      (pack_header[3] != PACK_RAW && pack_header[3] != PACK_COMPRESSED)) {
+    return false;
+  }
+
+  // The string pool, followed by the pack up to its lit-word table
+  const size_t entries_size = pack_header[0] * WORD_ENTRY_SIZE;
+  uint8_t * const buffer = malloc(pool_size + PACK_HEADER_SIZE + entries_size);
+  if (!buffer) return false;
+  uint8_t * const pool = buffer;
+  uint8_t * const pack = &buffer[pool_size];
+  const uint32_t table = offset + pack_size - LIT_TABLE_SIZE;
+  PackReader reader;
+  pack_reader_init(&reader, handle, offset + PACK_HEADER_SIZE, table - offset - PACK_HEADER_SIZE,
+                   pack_header[3] == PACK_COMPRESSED);
+  resource_load_byte_range(handle, pool_offset, pool, pool_size);
+  memcpy(pack, pack_header, PACK_HEADER_SIZE);
+  if (!pack_reader_read(&reader, &pack[PACK_HEADER_SIZE], entries_size) || !pack_reader_at_end(&reader) ||
+      !prv_validate_language_pack(handle, header, pool, pack, table)) {
+    free(buffer);
+    return false;
+  }
+
+  uint8_t i;
+  const uint8_t count = pack[0];
+  const uint8_t * const entries = &pack[PACK_HEADER_SIZE];
+
+  // Size the texts: an empty string, then each non-empty text plus its
+  // terminator. Derived texts with no letters to lowercase share the "on" text.
+  size_t text_size = 1;
+  for (i = 0; i < count; i++) {
+    const uint8_t * const e = &entries[i * WORD_ENTRY_SIZE];
+    const uint8_t on_len = e[1] >> 4;
+    const uint8_t off_len = e[1] & 0x0F;
+    const uint16_t on = prv_read_u16(&e[2]);
+    const uint16_t off = prv_read_u16(&e[4]);
+    if (on_len > 0) text_size += on_len + 1;
+    if (off == TEXT_DERIVED) {
+      for (uint8_t j = 0; j < on_len; j++) {
+        if (pool[on + j] >= 'A' && pool[on + j] <= 'Z') {
+          text_size += on_len + 1;
+          break;
+        }
+      }
+    } else if (off_len > 0) {
+      text_size += off_len + 1;
+    }
+  }
+  // Unpack into new arrays, so the current language stays intact if they
+  // cannot be allocated
+  char * const text = malloc(text_size);
+  word_t * const words = calloc(count + 1, sizeof(word_t));
+  if (!text || !words) {
+    free(text);
+    free(words);
+    free(buffer);
+    return false;
+  }
+  text[0] = '\0';
+
+  size_t pos = 1;
+  for (i = 1; i <= count; i++) {
+    word_t * const w = &words[i];
+
+    const uint8_t * const e = &entries[(i - 1) * WORD_ENTRY_SIZE];
+    const uint8_t on_len = e[1] >> 4;
+    const uint8_t off_len = e[1] & 0x0F;
+    const uint16_t on = prv_read_u16(&e[2]);
+    const uint16_t off = prv_read_u16(&e[4]);
+    w->row = (e[0] & 0b11110000) >> 4;
+    w->col = (e[0] & 0b00001111);
+    w->width = e[6];
+
+    if (on_len > 0) {
+      w->text_on = pos;
+      memcpy(&text[pos], &pool[on], on_len);
+      text[pos + on_len] = '\0';
+      pos += on_len + 1;
+    }
+
+    if (off == TEXT_DERIVED) {
+      bool changed = false;
+      for (uint8_t j = 0; j < on_len; j++) {
+        const char c = text[w->text_on + j];
+        text[pos + j] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+        changed |= text[pos + j] != c;
+      }
+      if (changed) {
+        w->text_off = pos;
+        text[pos + on_len] = '\0';
+        pos += on_len + 1;
+      } else {
+        w->text_off = w->text_on;
+      }
+    } else if (off_len > 0) {
+      w->text_off = pos;
+      memcpy(&text[pos], &pool[off], off_len);
+      text[pos + off_len] = '\0';
+      pos += off_len + 1;
+    }
+  }
+
+  free(word_text);
+  free(mywords);
+  word_text = text;
+  mywords = words;
+  word_count = count + 1;
+  language_handle = handle;
+  lit_table_offset = table;
+  free(buffer);
+  return true;
 }
 
 /**
  * Load language pack from resource file.
  *
  * Each language pack includes all of the words and the positions needed to
- * display the current time in that language.
+ * display the current time in that language, followed by the lit-word table.
+ * If the pack for the selected language is invalid, the en_US pack is used.
  */
 static void prv_load_language_from_resource_file(void) {
-  uint32_t resource_id = RESOURCE_ID_CHRONOCODE_EN_US;
-
-  switch (settings.language) {
-    case LANG_DA_DK: resource_id = RESOURCE_ID_CHRONOCODE_DA_DK; break;
-    case LANG_DE_DE: resource_id = RESOURCE_ID_CHRONOCODE_DE_DE; break;
-    case LANG_EN_US: resource_id = RESOURCE_ID_CHRONOCODE_EN_US; break;
-    case LANG_ES_ES: resource_id = RESOURCE_ID_CHRONOCODE_ES_ES; break;
-    case LANG_FR_FR: resource_id = RESOURCE_ID_CHRONOCODE_FR_FR; break;
-    case LANG_IT_IT: resource_id = RESOURCE_ID_CHRONOCODE_IT_IT; break;
-    case LANG_NB_NO: resource_id = RESOURCE_ID_CHRONOCODE_NB_NO; break;
-    case LANG_NL_BE: resource_id = RESOURCE_ID_CHRONOCODE_NL_BE; break;
-    case LANG_NL_NL: resource_id = RESOURCE_ID_CHRONOCODE_NL_NL; break;
-    case LANG_PT_PT: resource_id = RESOURCE_ID_CHRONOCODE_PT_PT; break;
-    case LANG_SV_SE: resource_id = RESOURCE_ID_CHRONOCODE_SV_SE; break;
-  }
-
-  // Load language file
-  uint8_t i;
-  uint16_t j;
-  uint8_t buffer[34];
-  ResHandle rh = resource_get_handle(resource_id);
-  for (i = 1; i < word_count; i++) {
-    resource_load_byte_range(rh, (i - 1) * 33, buffer, 33);
-    mywords[i].row = (buffer[0] & 0b11110000) >> 4;
-    mywords[i].col = (buffer[0] & 0b00001111);
-    memcpy(mywords[i].text_on, &buffer[1], 16);
-    memcpy(mywords[i].text_off, &buffer[17], 16);
-  }
-  // Load interval logic
-  j = (i - 1) * 33;
-  for (i = 0; i < 13; i++) {
-    resource_load_byte_range(rh, j + (i * 5), buffer, 5);
-    intervals[i][0] = buffer[0];
-    intervals[i][1] = buffer[1];
-    intervals[i][2] = buffer[2];
-    intervals[i][3] = buffer[3];
-    intervals[i][4] = buffer[4];
+  time_t start_s;
+  const uint16_t start_ms = time_ms(&start_s, NULL);
+
+  // The words must be looked up again in the new pack
+  lit_slot = -1;
+
+  if (!prv_load_language_pack(settings.language)) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Invalid language pack for language %d, falling back to en_US", settings.language);
+    if (settings.language == LANG_EN_US || !prv_load_language_pack(LANG_EN_US)) {
+      // Keep showing the current language, if there is one
+      APP_LOG(APP_LOG_LEVEL_ERROR, "No valid language pack");
+    }
   }
+
+  time_t end_s;
+  const uint16_t end_ms = time_ms(&end_s, NULL);
+  const int load_ms = (end_s - start_s) * 1000 + end_ms - start_ms;
+  APP_LOG(APP_LOG_LEVEL_DEBUG, "Loaded language %d in %d ms", settings.language, load_ms);
+  PERF_RECORD(PERF_LANGUAGE_LOAD, load_ms);
 }
 
 /**
@@ -408,6 +853,7 @@ static void prv_load_language_from_resource_file(void) {
  */
 static void prv_inbox_received_handler(DictionaryIterator *iter, void *context) {
   bool settings_changed = false;
+  bool language_changed = false;
 
   // All CAPS setting (Clay sends values as int32)
   Tuple *all_caps_tuple = dict_find(iter, MESSAGE_KEY_allCaps);
@@ -436,7 +882,7 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
     uint8_t new_lang = (uint8_t)language_tuple->value->int32;
     if (new_lang != settings.language) {
       settings.language = new_lang;
-      prv_load_language_from_resource_file();
+      language_changed = true;
       settings_changed = true;
     }
   }
@@ -445,8 +891,18 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
     // Save the new settings
     prv_save_settings();
 
+    // Reuse the existing layers for the new language's words
+    if (language_changed) {
+#ifdef SINGLE_LAYER_RENDERER
+      prv_load_language_from_resource_file();
+#else
+      prv_load_language_from_resource_file();
+      prv_resize_text_layers();
+#endif
+    }
+
     // Redraw watchface
-    prv_clear_watchface();
+    prv_restyle();
     prv_update_display_now();
   }
 }
@@ -459,26 +915,24 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
  * @param window Pointer to Window object
  */
 static void prv_window_load(Window *window) {
-  Layer *window_layer = window_get_root_layer(window);
-  GRect bounds = layer_get_bounds(window_layer);
-
-  // Load fonts
-  font_on = fonts_load_custom_font(resource_get_handle(FONT_ON));
-  font_off = fonts_load_custom_font(resource_get_handle(FONT_OFF));
+  // Load fonts (only needed without a glyph atlas)
+#ifdef GLYPH_ATLAS_RENDERER
+  glyph_atlas = glyph_atlas_create(RESOURCE_ID_GLYPH_ATLAS);
+  if (!glyph_atlas)
+#endif
+  {
+    // Color platforms use the same font for both, so load it only once
+    font_on = fonts_load_custom_font(resource_get_handle(FONT_ON));
+    font_off = FONT_OFF == FONT_ON ? font_on : fonts_load_custom_font(resource_get_handle(FONT_OFF));
+  }
 
   // Load language from resource file
   prv_load_language_from_resource_file();
 
-  // Initialize text layers for displaying words
-  memset(&text_layers, 0, sizeof(text_layers));
-  for (unsigned i = 0; i < word_count; i++) {
-    prv_word_layer_init(i);
-  }
+  prv_create_layers();
 
-  // Initialize a graphics layer for the minute indicator
-  minute_layer = layer_create(GRect(0, 0, bounds.size.w, bounds.size.h));
-  layer_set_update_proc(minute_layer, prv_minute_layer_update_callback);
-  layer_add_child(window_layer, minute_layer);
+  PERF_RECORD(PERF_HEAP_USED, heap_bytes_used());
+  PERF_RECORD(PERF_HEAP_FREE, heap_bytes_free());
 }
 
 /**
@@ -489,12 +943,23 @@ static void prv_window_load(Window *window) {
  * @param window Pointer to Window object
  */
 static void prv_window_unload(Window *window) {
-  for (unsigned i = 0; i < (sizeof(text_layers) / sizeof(*text_layers)); i++) {
-    text_layer_destroy(text_layers[i]);
+  prv_destroy_layers();
+  free(word_text);
+  free(mywords);
+  word_text = NULL;
+  mywords = NULL;
+  word_count = 1;
+#ifdef GLYPH_ATLAS_RENDERER
+  if (glyph_atlas) {
+    glyph_atlas_destroy(glyph_atlas);
+    glyph_atlas = NULL;
+    return;
+  }
+#endif
+  if (font_off != font_on) {
+    fonts_unload_custom_font(font_off);
   }
-  layer_destroy(minute_layer);
   fonts_unload_custom_font(font_on);
-  fonts_unload_custom_font(font_off);
 }
 
 /**
@@ -506,7 +971,11 @@ static void prv_init(void) {
 
   // Listen for AppMessages
   app_message_register_inbox_received(prv_inbox_received_handler);
+#ifdef PERF_INSTRUMENTATION
+  app_message_open(128, PERF_DATA_SIZE + 16); // Room for a dump of the measurements
+#else
   app_message_open(128, 128);
+#endif
 
   // Initialize window
   window = window_create();
@@ -522,6 +991,10 @@ static void prv_init(void) {
 
   // Subscribe to tick timer service to update watchface every minute
   tick_timer_service_subscribe(MINUTE_UNIT, prv_handle_minute_tick);
+
+#ifdef PERF_INSTRUMENTATION
+  perf_subscribe();
+#endif
 }
 
 /**
@@ -529,8 +1002,11 @@ static void prv_init(void) {
  *
  */
 static void prv_deinit(void) {
-  prv_save_settings();
+  // Settings were saved when they changed, so there is nothing to write here
   tick_timer_service_unsubscribe();
+#ifdef PERF_INSTRUMENTATION
+  perf_unsubscribe();
+#endif
   if (window) {
     window_destroy(window);
   }
@@ -544,4 +1020,5 @@ int main(void) {
   prv_init();
   app_event_loop();
   prv_deinit();
+  return 0;
 }
@@ -3,12 +3,85 @@
 
 #define SETTINGS_KEY 42
 
-#define FONT_H 18
+// Layout of the word grid (12 columns by 9 rows) for each screen. FONT_W
+// and FONT_H are the grid cell size, FONT_W being the advance of the font at
+// FONT_SIZE pixels (SourceCodePro advances 0.6 em) so that the letters of a
+// word line up with the grid. GRID_X/GRID_Y offset the grid on the screen, and
+// MINUTE_INSET_X/Y the minute indicator from the screen corners; on round
+// screens both are inset to keep them inside the circle.
+#if defined(PBL_PLATFORM_EMERY)
+// 200x228
+#define FONT_SIZE 27
+#define FONT_W 16
+#define FONT_H 24
+#define GRID_X 4
+#define GRID_Y 6
+#define MINUTE_INSET_X 0
+#define MINUTE_INSET_Y 0
+#define FONT_ON  RESOURCE_ID_FONT_SOURCECODEPRO_BLACK_27
+#elif defined(PBL_PLATFORM_CHALK)
+// 180x180 round
+#define FONT_SIZE 17
+#define FONT_W 10
+#define FONT_H 14
+#define GRID_X 30
+#define GRID_Y 27
+#define MINUTE_INSET_X 24
+#define MINUTE_INSET_Y 31
+#define FONT_ON  RESOURCE_ID_FONT_SOURCECODEPRO_BLACK_17
+#elif defined(PBL_PLATFORM_GABBRO)
+// 260x260 round
+#define FONT_SIZE 24
+#define FONT_W 14
+#define FONT_H 21
+#define GRID_X 46
+#define GRID_Y 35
+#define MINUTE_INSET_X 38
+#define MINUTE_INSET_Y 40
+#define FONT_ON  RESOURCE_ID_FONT_SOURCECODEPRO_BLACK_24
+#else
+// 144x168 aplite, basalt, diorite, flint
+#define FONT_SIZE 20
 #define FONT_W 12
+#define FONT_H 18
+#define GRID_X 0
+#define GRID_Y 0
+#define MINUTE_INSET_X 0
+#define MINUTE_INSET_Y 0
 #define FONT_ON  RESOURCE_ID_FONT_SOURCECODEPRO_BLACK_20
+#endif
+
+// Frame of a word's text, relative to its grid cell: tall enough for the
+// font's line height, starting a little above the cell
+#define WORD_Y (-(FONT_SIZE / 10))
+#define WORD_H (FONT_SIZE * 13 / 10)
+
+// Draw all words from a single layer instead of creating one TextLayer per
+// word. Saves a heap allocation per word, which matters most on aplite.
+//#define SINGLE_LAYER_RENDERER
+
+// Blit words from a pre-rendered glyph atlas (resources/atlas, generated by
+// cclp/ccga) instead of rasterizing the fonts on each redraw. Implies
+// SINGLE_LAYER_RENDERER; falls back to the fonts if the atlas can't be loaded.
+//#define GLYPH_ATLAS_RENDERER
+
+#if defined(GLYPH_ATLAS_RENDERER) && !defined(SINGLE_LAYER_RENDERER)
+#define SINGLE_LAYER_RENDERER
+#endif
+
+// The atlases are only generated for the 20px fonts of the 144x168 screens,
+// so other screens draw the single layer with the fonts
+#if defined(GLYPH_ATLAS_RENDERER) && FONT_SIZE != 20
+#undef GLYPH_ATLAS_RENDERER
+#endif
+
+// Record display update and redraw times, language load times and heap use,
+// dumped to the app log and sent to the phone when the watch is tapped (see
+// perf.h).
+//#define PERF_INSTRUMENTATION
 
 #ifdef PBL_COLOR
-#define FONT_OFF RESOURCE_ID_FONT_SOURCECODEPRO_BLACK_20
+#define FONT_OFF FONT_ON
 #else
 #define FONT_OFF RESOURCE_ID_FONT_SOURCECODEPRO_LIGHT_20
 #endif
@@ -0,0 +1,170 @@
+/**
+ * Glyph atlas loading and blitting
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <pebble.h>
+#include "glyph_atlas.h"
+
+enum {
+  ATLAS_VERSION = 1,      /**< Supported atlas format version */
+  ATLAS_HEADER_SIZE = 12, /**< Bytes before the glyph index */
+  ATLAS_ENTRY_SIZE = 4    /**< Bytes per glyph index entry */
+};
+
+struct GlyphAtlas {
+  uint8_t bpp;            /**< Bits per pixel of the cells (1 or 2) */
+  uint8_t cell_w;         /**< Cell width in pixels */
+  uint8_t cell_h;         /**< Cell height in pixels */
+  uint8_t stride;         /**< Bytes per cell row */
+  uint16_t count;         /**< Number of glyphs */
+  uint16_t cell_size;     /**< Bytes per cell */
+  const uint8_t *index;   /**< Glyph index, sorted by code point then weight */
+  const uint8_t *cells;   /**< Glyph cells, in index order */
+  uint8_t data[];         /**< The atlas resource */
+};
+
+static uint16_t prv_read_u16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+
+/**
+ * Decode one UTF-8 sequence, returning the number of bytes consumed.
+ */
+static int prv_utf8_decode(const char *s, uint16_t *cp) {
+  const uint8_t *u = (const uint8_t *)s;
+  if (u[0] < 0x80) {
+    *cp = u[0];
+    return 1;
+  } else if ((u[0] & 0xE0) == 0xC0 && u[1]) {
+    *cp = ((u[0] & 0x1F) << 6) | (u[1] & 0x3F);
+    return 2;
+  } else if ((u[0] & 0xF0) == 0xE0 && u[1] && u[2]) {
+    *cp = ((u[0] & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+    return 3;
+  }
+  *cp = 0;
+  return 1;
+}
+
+/**
+ * Find the cell of a glyph.
+ *
+ * Atlases for platforms whose on and off fonts are identical only hold the
+ * "on" weight, so a missing "off" glyph falls back to the "on" one.
+ *
+ * @return Pointer to the glyph's cell, or NULL if it is not in the atlas
+ */
+static const uint8_t *prv_find_cell(const GlyphAtlas *atlas, uint16_t cp, uint8_t weight) {
+  const uint32_t key = ((uint32_t)cp << 8) | weight;
+  int lo = 0;
+  int hi = atlas->count - 1;
+
+  while (lo <= hi) {
+    const int mid = (lo + hi) / 2;
+    const uint8_t *entry = &atlas->index[mid * ATLAS_ENTRY_SIZE];
+    const uint32_t mid_key = ((uint32_t)prv_read_u16(entry) << 8) | entry[2];
+    if (mid_key == key) return &atlas->cells[mid * atlas->cell_size];
+    if (mid_key < key) lo = mid + 1;
+    else hi = mid - 1;
+  }
+  return weight == GLYPH_WEIGHT_OFF ? prv_find_cell(atlas, cp, GLYPH_WEIGHT_ON) : NULL;
+}
+
+GlyphAtlas *glyph_atlas_create(uint32_t resource_id) {
+  ResHandle rh = resource_get_handle(resource_id);
+  const size_t size = resource_size(rh);
+  if (size < ATLAS_HEADER_SIZE) return NULL;
+
+  GlyphAtlas *atlas = malloc(sizeof(GlyphAtlas) + size);
+  if (!atlas) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Not enough memory for glyph atlas (%u bytes)", (unsigned)size);
+    return NULL;
+  }
+  resource_load(rh, atlas->data, size);
+
+  const uint8_t *d = atlas->data;
+  atlas->bpp = d[5];
+  atlas->cell_w = d[6];
+  atlas->cell_h = d[7];
+  atlas->count = prv_read_u16(&d[8]);
+  atlas->cell_size = prv_read_u16(&d[10]);
+  atlas->stride = (atlas->cell_w * atlas->bpp + 7) / 8;
+  atlas->index = &d[ATLAS_HEADER_SIZE];
+  atlas->cells = atlas->index + atlas->count * ATLAS_ENTRY_SIZE;
+
+  if (memcmp(d, "CCGA", 4) != 0 || d[4] != ATLAS_VERSION || (atlas->bpp != 1 && atlas->bpp != 2) ||
+      atlas->cell_size != atlas->stride * atlas->cell_h ||
+      ATLAS_HEADER_SIZE + atlas->count * (ATLAS_ENTRY_SIZE + atlas->cell_size) > size) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Invalid glyph atlas");
+    free(atlas);
+    return NULL;
+  }
+  return atlas;
+}
+
+void glyph_atlas_destroy(GlyphAtlas *atlas) {
+  free(atlas);
+}
+
+/**
+ * Blit one cell. Coverage levels between none and full (2-bit atlases) are
+ * blended with the pixels already in the frame buffer.
+ */
+static void prv_blit_cell(const GlyphAtlas *atlas, GBitmap *fb, const uint8_t *cell, GPoint origin, GColor color) {
+  const GRect bounds = gbitmap_get_bounds(fb);
+  #ifndef PBL_COLOR
+  uint8_t * const data = gbitmap_get_data(fb);
+  const uint16_t bytes_per_row = gbitmap_get_bytes_per_row(fb);
+  const bool white = gcolor_equal(color, GColorWhite);
+  #endif
+
+  for (int y = 0; y < atlas->cell_h; y++) {
+    const int sy = origin.y + y;
+    if (sy < bounds.origin.y || sy >= bounds.origin.y + bounds.size.h) continue;
+    const uint8_t * const row = &cell[y * atlas->stride];
+    #ifdef PBL_COLOR
+    const GBitmapDataRowInfo info = gbitmap_get_data_row_info(fb, sy);
+    #endif
+
+    for (int x = 0; x < atlas->cell_w; x++) {
+      const int sx = origin.x + x;
+      const uint8_t level = atlas->bpp == 1
+        ? ((row[x >> 3] >> (7 - (x & 7))) & 1) * 3
+        : (row[x >> 2] >> (6 - 2 * (x & 3))) & 3;
+      if (level == 0) continue;
+
+      #ifdef PBL_COLOR
+      if (sx < info.min_x || sx > info.max_x) continue;
+      GColor8 * const px = (GColor8 *)&info.data[sx];
+      if (level == 3) {
+        *px = color;
+      } else {
+        px->r = (color.r * level + px->r * (3 - level) + 1) / 3;
+        px->g = (color.g * level + px->g * (3 - level) + 1) / 3;
+        px->b = (color.b * level + px->b * (3 - level) + 1) / 3;
+      }
+      #else
+      if (sx < bounds.origin.x || sx >= bounds.origin.x + bounds.size.w || level < 2) continue;
+      uint8_t * const byte = &data[sy * bytes_per_row + (sx >> 3)];
+      if (white) *byte |= 1 << (sx & 7);
+      else *byte &= ~(1 << (sx & 7));
+      #endif
+    }
+  }
+}
+
+void glyph_atlas_draw_text(const GlyphAtlas *atlas, GBitmap *fb, const char *text, GPoint origin,
+                           uint8_t weight, GColor color) {
+  uint16_t cp;
+  while (*text) {
+    text += prv_utf8_decode(text, &cp);
+    const uint8_t *cell = prv_find_cell(atlas, cp, weight);
+    if (cell) {
+      prv_blit_cell(atlas, fb, cell, origin, color);
+    }
+    origin.x += atlas->cell_w;
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <pebble.h>
+
+/**
+ * A glyph atlas: pre-rendered glyph cells for the characters used by the
+ * language packs, generated by `cclp/ccga` (see cclp/src/ccga.c for the
+ * resource format).
+ */
+typedef struct GlyphAtlas GlyphAtlas;
+
+// Glyph weights stored in the atlas
+enum {
+  GLYPH_WEIGHT_ON  = 0, /**< Weight of words that are "on" (FONT_ON) */
+  GLYPH_WEIGHT_OFF = 1  /**< Weight of words that are "off" (FONT_OFF) */
+};
+
+/**
+ * Load a glyph atlas from a resource.
+ *
+ * @param resource_id The resource containing the atlas
+ * @return The atlas, or NULL if the resource is not a valid atlas or there is not enough memory
+ */
+GlyphAtlas *glyph_atlas_create(uint32_t resource_id);
+
+/**
+ * Free a glyph atlas.
+ *
+ * @param atlas The atlas to free
+ */
+void glyph_atlas_destroy(GlyphAtlas *atlas);
+
+/**
+ * Blit a line of text into a captured frame buffer, one cell per character.
+ *
+ * Characters missing from the atlas are skipped, leaving an empty cell.
+ *
+ * @param atlas  The atlas to draw from
+ * @param fb     The frame buffer, from graphics_capture_frame_buffer()
+ * @param text   UTF-8 text to draw
+ * @param origin Top-left corner of the first cell, in frame buffer coordinates
+ * @param weight GLYPH_WEIGHT_ON or GLYPH_WEIGHT_OFF
+ * @param color  Text color
+ */
+void glyph_atlas_draw_text(const GlyphAtlas *atlas, GBitmap *fb, const char *text, GPoint origin,
+                           uint8_t weight, GColor color);
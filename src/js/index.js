@@ -1,3 +1,24 @@
 var Clay = require('@rebble/clay');
 var clayConfig = require('./config.json');
 var clay = new Clay(clayConfig);
+
+// Performance measurements sent by a PERF_INSTRUMENTATION build (see src/perf.h)
+var perfKinds = ['update_display ms', 'word_layer_update ms', 'minute_layer_update ms', 'language_load ms',
+  'heap_used', 'heap_free'];
+
+Pebble.addEventListener('appmessage', function(e) {
+  var data = e.payload.perfData;
+  if (!data) {
+    return;
+  }
+  var u32 = function(offset) {
+    return (data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) | (data[offset + 3] << 24)) >>> 0;
+  };
+  for (var i = 0; i < perfKinds.length && i * 16 + 16 <= data.length; i++) {
+    var count = u32(i * 16);
+    if (count) {
+      console.log('perf ' + perfKinds[i] + ': n ' + count + ' min ' + u32(i * 16 + 4) + ' max ' +
+        u32(i * 16 + 8) + ' mean ' + (u32(i * 16 + 12) / count).toFixed(3));
+    }
+  }
+});
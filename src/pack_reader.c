@@ -0,0 +1,89 @@
+/**
+ * Streaming reader of raw and compressed language pack word entries
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <pebble.h>
+#include "pack_reader.h"
+
+enum { MIN_MATCH = 3 }; /**< Length of a match whose token field is 0 */
+
+void pack_reader_init(PackReader *reader, ResHandle handle, uint32_t offset, uint32_t size, bool compressed) {
+  memset(reader, 0, sizeof(*reader));
+  reader->handle = handle;
+  reader->offset = offset;
+  reader->end = offset + size;
+  reader->compressed = compressed;
+}
+
+/**
+ * Get the next byte of compressed data, reading another chunk when needed.
+ */
+static uint8_t prv_next_byte(PackReader *reader) {
+  if (reader->chunk_pos == reader->chunk_len) {
+    const uint32_t left = reader->end - reader->offset;
+    if (left == 0) {
+      reader->failed = true;
+      return 0;
+    }
+    reader->chunk_len = left < PACK_READER_CHUNK_SIZE ? left : PACK_READER_CHUNK_SIZE;
+    reader->chunk_pos = 0;
+    resource_load_byte_range(reader->handle, reader->offset, reader->chunk, reader->chunk_len);
+    reader->offset += reader->chunk_len;
+  }
+  return reader->chunk[reader->chunk_pos++];
+}
+
+/**
+ * Add the continuation bytes of a token field to it.
+ */
+static uint16_t prv_read_length(PackReader *reader, uint16_t length) {
+  if (length < 15) return length;
+  uint8_t b;
+  do {
+    b = prv_next_byte(reader);
+    length += b;
+  } while (b == 255 && !reader->failed);
+  return length;
+}
+
+bool pack_reader_read(PackReader *reader, uint8_t *data, size_t size) {
+  if (!reader->compressed) {
+    if (size > reader->end - reader->offset) return false;
+    if (data) resource_load_byte_range(reader->handle, reader->offset, data, size);
+    reader->offset += size;
+    return true;
+  }
+
+  size_t i = 0;
+  while (i < size && !reader->failed) {
+    uint8_t c;
+    if (reader->literals > 0) {
+      c = prv_next_byte(reader);
+      reader->literals--;
+    } else if (reader->match > 0) {
+      if (!reader->distance) reader->distance = prv_next_byte(reader) + 1;
+      c = reader->window[(uint8_t)(reader->window_pos - reader->distance) % PACK_READER_WINDOW_SIZE];
+      reader->match--;
+    } else {
+      // Start of a sequence
+      const uint8_t token = prv_next_byte(reader);
+      reader->literals = prv_read_length(reader, token >> 4);
+      reader->match = prv_read_length(reader, token & 0x0F) + MIN_MATCH;
+      reader->distance = 0;
+      continue;
+    }
+    reader->window[reader->window_pos++ % PACK_READER_WINDOW_SIZE] = c;
+    if (data) data[i] = c;
+    i++;
+  }
+  return !reader->failed;
+}
+
+bool pack_reader_at_end(const PackReader *reader) {
+  if (!reader->compressed) return reader->offset == reader->end;
+  return !reader->failed && reader->offset == reader->end && reader->chunk_pos == reader->chunk_len &&
+         reader->literals == 0;
+}
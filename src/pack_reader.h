@@ -0,0 +1,63 @@
+#pragma once
+#include <pebble.h>
+
+/**
+ * A reader of the word entries of a language pack, which may be stored raw
+ * or compressed (see cclp/src/lz.h for the encoding). The lit-word table
+ * after them is always raw, and is read directly.
+ *
+ * Compressed entries are decoded while they are read from the resource a
+ * small chunk at a time, keeping only the last PACK_READER_WINDOW_SIZE
+ * decoded bytes, which matches can refer back to. Reading compressed entries
+ * can only go forward from their start.
+ */
+
+enum {
+  PACK_READER_CHUNK_SIZE = 64,   /**< Compressed bytes read from the resource at a time */
+  PACK_READER_WINDOW_SIZE = 128  /**< Decoded bytes kept for matches (a power of two) */
+};
+
+typedef struct {
+  ResHandle handle;
+  uint32_t offset;     /**< Offset of the next byte of the entries in the resource */
+  uint32_t end;        /**< Offset of the end of the entries in the resource */
+  bool compressed;
+  bool failed;         /**< True if compressed data was read past its end */
+  uint16_t literals;   /**< Literals left in the current sequence */
+  uint16_t match;      /**< Bytes left to copy in the current sequence's match */
+  uint8_t distance;    /**< Distance of the current match, or 0 if not read yet */
+  uint8_t window_pos;  /**< Position of the next decoded byte in the window */
+  uint8_t chunk_pos;   /**< Position of the next compressed byte in the chunk */
+  uint8_t chunk_len;   /**< Bytes in the chunk */
+  uint8_t chunk[PACK_READER_CHUNK_SIZE];
+  uint8_t window[PACK_READER_WINDOW_SIZE];
+} PackReader;
+
+/**
+ * Set up a reader at the start of a pack's word entries.
+ *
+ * @param reader     The reader
+ * @param handle     The language packs resource
+ * @param offset     Offset of the word entries in the resource
+ * @param size       Size of the word entries in the resource
+ * @param compressed True if the entries are compressed
+ */
+void pack_reader_init(PackReader *reader, ResHandle handle, uint32_t offset, uint32_t size, bool compressed);
+
+/**
+ * Read the next bytes of the word entries.
+ *
+ * @param reader The reader
+ * @param data   Buffer for the bytes, or NULL to skip them
+ * @param size   Number of bytes to read
+ * @return True if all the bytes were read, false if the entries ended first
+ */
+bool pack_reader_read(PackReader *reader, uint8_t *data, size_t size);
+
+/**
+ * Check whether all of the word entries have been read.
+ *
+ * @param reader The reader
+ * @return True if there is no data left
+ */
+bool pack_reader_at_end(const PackReader *reader);
@@ -0,0 +1,75 @@
+/**
+ * Performance instrumentation slots
+ *
+ * @license New BSD License (please see LICENSE file)
+ * @repo https://github.com/rexmac/pebble-chronocode
+ * @author Rex McConnell <rex@rexmac.com>
+ */
+#include <pebble.h>
+#include "perf.h"
+
+#ifdef PERF_INSTRUMENTATION
+
+// Laid out as it is sent in perfData, which is little-endian like the watch
+typedef struct {
+  uint32_t count; /**< Number of measurements */
+  uint32_t min;   /**< Smallest measured value */
+  uint32_t max;   /**< Largest measured value */
+  uint32_t sum;   /**< Sum of the measured values */
+} PerfSlot;
+
+static const char * const kind_names[PERF_KIND_COUNT] = {
+  "update_display ms", "word_layer_update ms", "minute_layer_update ms", "language_load ms", "heap_used", "heap_free"
+};
+
+static PerfSlot slots[PERF_KIND_COUNT]; /**< Measurements by kind */
+
+uint32_t perf_now_ms(void) {
+  time_t s;
+  const uint16_t ms = time_ms(&s, NULL);
+  return (uint32_t)s * 1000 + ms;
+}
+
+void perf_record(uint8_t kind, uint32_t value) {
+  if (kind >= PERF_KIND_COUNT) return;
+  PerfSlot * const s = &slots[kind];
+  if (s->count == 0 || value < s->min) s->min = value;
+  if (value > s->max) s->max = value;
+  s->sum += value;
+  s->count++;
+}
+
+void perf_dump(void) {
+  for (uint8_t kind = 0; kind < PERF_KIND_COUNT; kind++) {
+    const PerfSlot * const s = &slots[kind];
+    if (s->count == 0) continue;
+    // Mean in thousandths, as most timings are below the millisecond resolution
+    APP_LOG(APP_LOG_LEVEL_INFO, "perf %s: n %lu min %lu max %lu mean %lu.%03lu", kind_names[kind],
+            (unsigned long)s->count, (unsigned long)s->min, (unsigned long)s->max,
+            (unsigned long)(s->sum / s->count),
+            (unsigned long)((uint64_t)(s->sum % s->count) * 1000 / s->count));
+  }
+
+  DictionaryIterator *iter;
+  if (app_message_outbox_begin(&iter) == APP_MSG_OK) {
+    dict_write_data(iter, MESSAGE_KEY_perfData, (const uint8_t *)slots, sizeof(slots));
+    app_message_outbox_send();
+  }
+}
+
+/**
+ * Called when the watch is tapped.
+ */
+static void prv_tap_handler(AccelAxisType axis, int32_t direction) {
+  perf_dump();
+}
+
+void perf_subscribe(void) {
+  accel_tap_service_subscribe(prv_tap_handler);
+}
+
+void perf_unsubscribe(void) {
+  accel_tap_service_unsubscribe();
+}
+
+#endif
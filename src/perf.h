@@ -0,0 +1,77 @@
+#pragma once
+#include <pebble.h>
+#include "chronocode.h"
+
+/**
+ * Performance instrumentation (PERF_INSTRUMENTATION in chronocode.h).
+ *
+ * Each kind of measurement has its own slot in RAM holding the number of
+ * measurements and their minimum, maximum and sum, so the per-tick timings
+ * never push out the one-off ones. A tap on the watch (a flick of the wrist)
+ * writes the slots to the app log and sends them to the phone, whose
+ * JavaScript logs them. Without PERF_INSTRUMENTATION the macros below
+ * compile to nothing.
+ *
+ * Durations come from time_ms(), which only has millisecond resolution, so a
+ * single update that takes less than that is usually measured as 0 ms (and
+ * sometimes as 1 ms). Each measurement is off by less than a millisecond, as
+ * likely one way as the other, so the mean over many ticks (the sum divided
+ * by the count) is accurate to well under a millisecond.
+ */
+
+// Kinds of measurement
+enum {
+  PERF_UPDATE_DISPLAY = 0,     /**< Duration of prv_update_display(), in ms */
+  PERF_WORD_LAYER_UPDATE = 1,  /**< Duration of the word layer update proc, in ms */
+  PERF_MINUTE_LAYER_UPDATE = 2, /**< Duration of the minute layer update proc, in ms */
+  PERF_LANGUAGE_LOAD = 3,      /**< Duration of a language pack load, in ms */
+  PERF_HEAP_USED = 4,          /**< heap_bytes_used() after the window loaded */
+  PERF_HEAP_FREE = 5,          /**< heap_bytes_free() after the window loaded */
+  PERF_KIND_COUNT = 6
+};
+
+#define PERF_DATA_SIZE (PERF_KIND_COUNT * 16) /**< Size of the perfData byte array */
+
+#ifdef PERF_INSTRUMENTATION
+
+/**
+ * Get a millisecond timestamp for measuring durations.
+ */
+uint32_t perf_now_ms(void);
+
+/**
+ * Add a measurement to the slot of its kind.
+ *
+ * @param kind  The kind of measurement (PERF_*)
+ * @param value The measured value
+ */
+void perf_record(uint8_t kind, uint32_t value);
+
+/**
+ * Write the slots to the app log, and send them to the phone as a byte array
+ * under MESSAGE_KEY_perfData: for each kind in order, uint32 count, minimum,
+ * maximum and sum, little-endian (PERF_DATA_SIZE bytes).
+ */
+void perf_dump(void);
+
+/**
+ * Dump the measurements whenever the watch is tapped.
+ */
+void perf_subscribe(void);
+
+/**
+ * Stop dumping the measurements on taps.
+ */
+void perf_unsubscribe(void);
+
+#define PERF_START(var) const uint32_t var = perf_now_ms()
+#define PERF_END(kind, var) perf_record((kind), perf_now_ms() - (var))
+#define PERF_RECORD(kind, value) perf_record((kind), (value))
+
+#else
+
+#define PERF_START(var)
+#define PERF_END(kind, var)
+#define PERF_RECORD(kind, value)
+
+#endif